@@ -1,31 +1,46 @@
 //sources
 // Matematikk3_V24_VSIM101_H24 Document
 // Assistance from ChatGPT
+// Piegl, Tiller - The NURBS Book (1997)
 
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
 #include <cmath>
 
-// Defining Control Points
-std::vector<std::vector<GLfloat>> controlPoints = 
-{
-    { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f }, 
-    { 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 1.0f, 2.0f, 3.0f, 1.0f, 0.0f }, 
-    { 0.0f, 2.0f, 0.0f, 1.0f, 2.0f, 0.0f, 2.0f, 2.0f, 0.0f, 3.0f, 2.0f, 0.0f } 
-};
-
-// Knot Vector
-GLfloat mu[] = { 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 2.0f, 2.0f };
-GLfloat mv[] = { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+#include "BSplineBasis.h"
+#include "BSplineBatch.h"
+#include "BSplineSurface.h"
+#include "Profiling.h"
+#include "SplineRenderer.h"
 
 // Fixed Rotation Angles
 float rotationAngleX = -607.0f;
 float rotationAngleY = 187.0f;
 float cameraDistance = 6.0f;
 
-// B-spline Function
-float B(int i, int degree, float t, GLfloat* knots) 
+// The Viewer's Surface: Degree 2 Both Ways, 4 Control Points Along u and 3 Rows Along v, Clamped Knots
+BSplineSurface<2, 2> demoSurface() 
+{
+    std::vector<glm::vec3> controlPoints = 
+    {
+        { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 0.0f }, { 3.0f, 0.0f, 0.0f }, 
+        { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 2.0f }, { 2.0f, 1.0f, 2.0f }, { 3.0f, 1.0f, 0.0f }, 
+        { 0.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f }, { 2.0f, 2.0f, 0.0f }, { 3.0f, 2.0f, 0.0f } 
+    };
+    BSplineSurface<2, 2> surface;
+    surface.reset(std::move(controlPoints), 4, 3, { 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 2.0f, 2.0f }, { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f });
+    return surface;
+}
+
+// B-spline Function, Recursive Cox-de Boor; Kept as the Benchmark Reference
+float B(int i, int degree, float t, const float* knots) 
 {
     if (degree == 0) 
     {
@@ -50,71 +65,283 @@ float B(int i, int degree, float t, GLfloat* knots)
     return left + right;
 }
 
-// Evaluate Point on Surface
-void evaluateBSplineSurface(float u, float v, float& x, float& y, float& z) 
+// Evaluate Point on Surface Through the Recursive Basis, Every Control Point Visited
+template <typename Surface>
+glm::vec3 evaluateBSplineSurfaceRecursive(const Surface& surface, float u, float v) 
 {
-    int du = 2, dv = 2;
-    x = y = z = 0.0f;
+    glm::vec3 point(0.0f);
+    for (int i = 0; i < surface.countU; i++) 
+    {
+        for (int j = 0; j < surface.countV; j++) 
+        {
+            float Bu = B(i, surface.degreeU, u, surface.knotsU.data());
+            float Bv = B(j, surface.degreeV, v, surface.knotsV.data());
+            point += surface.controlPoints[size_t(j) * surface.countU + i] * (Bu * Bv);
+        }
+    }
+    return point;
+}
 
-    for (int i = 0; i < 4; i++) 
+// Time the Point Evaluators and the Table Tessellator Over the Same Grid at Several Densities; the Recursive Basis
+// Is Zero at the Closing Knot, So That Comparison Skips the Last Row and Column
+void runBasisBenchmark() 
+{
+    const BSplineSurface<2, 2> surface = demoSurface();
+    const int densities[] = { 20, 100, 500, 2000 };
+    for (int samples : densities) 
     {
-        for (int j = 0; j < 3; j++) 
+        float minU = surface.knotsU[surface.degreeU], minV = surface.knotsV[surface.degreeV];
+        float spanU = surface.knotsU[surface.countU] - minU, spanV = surface.knotsV[surface.countV] - minV;
+        size_t count = size_t(samples + 1) * (samples + 1);
+        std::vector<glm::vec3> recursive(count), iterative(count);
+
+        Stopwatch recursiveTimer;
+        for (int a = 0; a <= samples; a++) 
+        {
+            for (int b = 0; b <= samples; b++) 
+            {
+                recursive[size_t(a) * (samples + 1) + b] = evaluateBSplineSurfaceRecursive(surface, minU + spanU * a / samples, minV + spanV * b / samples);
+            }
+        }
+        double recursiveSeconds = recursiveTimer.seconds();
+
+        Stopwatch iterativeTimer;
+        for (int a = 0; a <= samples; a++) 
+        {
+            for (int b = 0; b <= samples; b++) 
+            {
+                iterative[size_t(a) * (samples + 1) + b] = surface.evaluate(minU + spanU * a / samples, minV + spanV * b / samples);
+            }
+        }
+        double iterativeSeconds = iterativeTimer.seconds();
+
+        Stopwatch buildTimer;
+        BasisTable uTable, vTable;
+        buildUniformBasisTable(surface.knotsU.data(), surface.countU, surface.degreeU, samples + 1, uTable);
+        buildUniformBasisTable(surface.knotsV.data(), surface.countV, surface.degreeV, samples + 1, vTable);
+        double buildSeconds = buildTimer.seconds();
+
+        std::vector<glm::vec3> tabulated(count);
+        Stopwatch tableTimer;
+        evaluateSurfaceGrid(uTable, vTable, surface.controlPoints.data(), surface.countU, tabulated.data());
+        double tableSeconds = tableTimer.seconds();
+
+        float difference = 0.0f, tableDifference = 0.0f;
+        for (int a = 0; a <= samples; a++) 
         {
-            float Bu = B(i, du, u, mu);
-            float Bv = B(j, dv, v, mv);
-            x += controlPoints[j][i * 3] * Bu * Bv;
-            y += controlPoints[j][i * 3 + 1] * Bu * Bv;
-            z += controlPoints[j][i * 3 + 2] * Bu * Bv;
+            for (int b = 0; b <= samples; b++) 
+            {
+                glm::vec3 delta = glm::abs(tabulated[size_t(b) * (samples + 1) + a] - iterative[size_t(a) * (samples + 1) + b]);
+                tableDifference = std::max(tableDifference, std::max(delta.x, std::max(delta.y, delta.z)));
+            }
         }
+        for (int a = 0; a < samples; a++) 
+        {
+            for (int b = 0; b < samples; b++) 
+            {
+                glm::vec3 delta = glm::abs(recursive[size_t(a) * (samples + 1) + b] - iterative[size_t(a) * (samples + 1) + b]);
+                difference = std::max(difference, std::max(delta.x, std::max(delta.y, delta.z)));
+            }
+        }
+
+        std::cout << samples << " x " << samples << " grid: recursive " << recursiveSeconds * 1000.0 << " ms, iterative "
+                  << iterativeSeconds * 1000.0 << " ms (" << recursiveSeconds / std::max(iterativeSeconds, 1e-9)
+                  << "x), max difference " << difference << std::endl;
+        std::cout << "    tables: build " << buildSeconds * 1000.0 << " ms, evaluate " << tableSeconds * 1000.0 << " ms ("
+                  << iterativeSeconds / std::max(tableSeconds, 1e-9) << "x over iterative), max difference " << tableDifference << std::endl;
     }
 }
 
-// Render Wireframe
-void renderBSplineWireframe() 
+// Uniform Cubic Patch of side x side Control Points Over a Sine-Cosine Height Field, Knots 0, 1, 2, ...
+BSplineSurface<3, 3> wavePatch(int side) 
 {
-    float step = 0.05f;
-    glBegin(GL_LINES);
-    for (float u = 0.0f; u <= 2.0f; u += step) 
+    std::vector<glm::vec3> patch;
+    for (int j = 0; j < side; j++) 
     {
-        for (float v = 0.0f; v <= 1.0f; v += step) 
+        for (int i = 0; i < side; i++) patch.push_back(glm::vec3(i, j, std::sin(i * 0.7f) * std::cos(j * 0.5f)));
+    }
+    std::vector<float> knots(side + 4);
+    for (size_t k = 0; k < knots.size(); k++) knots[k] = static_cast<float>(k);
+    BSplineSurface<3, 3> cubic;
+    cubic.reset(std::move(patch), side, side, knots, knots);
+    return cubic;
+}
+
+// Evaluate a Surface Over a samples x samples Grid of Its Valid Parameter Range, Returns Seconds
+template <typename Surface>
+double timeSurfaceGrid(const Surface& surface, int samples, std::vector<glm::vec3>& out) 
+{
+    float minU = surface.knotsU[surface.degreeU], maxU = surface.knotsU[surface.countU];
+    float minV = surface.knotsV[surface.degreeV], maxV = surface.knotsV[surface.countV];
+    out.resize(size_t(samples + 1) * (samples + 1));
+    Stopwatch timer;
+    for (int b = 0; b <= samples; b++) 
+    {
+        for (int a = 0; a <= samples; a++) 
         {
-            float x1, y1, z1, x2, y2, z2, x3, y3, z3;
-            evaluateBSplineSurface(u, v, x1, y1, z1);
-            evaluateBSplineSurface(u + step, v, x2, y2, z2);
-            evaluateBSplineSurface(u, v + step, x3, y3, z3);
+            out[size_t(b) * (samples + 1) + a] = surface.evaluate(minU + (maxU - minU) * a / samples, minV + (maxV - minV) * b / samples);
+        }
+    }
+    return timer.seconds();
+}
+
+// Time Compile-Time Degrees Against the Runtime-Degree Fallback on Two Surfaces
+template <typename Fixed>
+void compareSurfaceDegrees(const char* label, const Fixed& fixed, const RuntimeBSplineSurface& runtime, int samples) 
+{
+    std::vector<glm::vec3> fixedPoints, runtimePoints;
+    double fixedSeconds = timeSurfaceGrid(fixed, samples, fixedPoints);
+    double runtimeSeconds = timeSurfaceGrid(runtime, samples, runtimePoints);
+    float difference = 0.0f;
+    for (size_t i = 0; i < fixedPoints.size(); i++) 
+    {
+        glm::vec3 delta = glm::abs(fixedPoints[i] - runtimePoints[i]);
+        difference = std::max(difference, std::max(delta.x, std::max(delta.y, delta.z)));
+    }
+    std::cout << label << ", " << samples << " x " << samples << " grid: template " << fixedSeconds * 1000.0 << " ms, runtime degree "
+              << runtimeSeconds * 1000.0 << " ms (" << runtimeSeconds / std::max(fixedSeconds, 1e-9) << "x), max difference "
+              << difference << std::endl;
+}
+
+// The Clamped Demo Surface, and a Uniform Cubic Patch Where the Basis Matrix Replaces the Recurrence
+void runSurfaceTemplateBenchmark() 
+{
+    const int samples = 1000;
+    BSplineSurface<2, 2> demo = demoSurface();
+    RuntimeBSplineSurface demoRuntime;
+    demoRuntime.reset(demo.controlPoints, demo.countU, demo.countV, demo.knotsU, demo.knotsV, demo.degreeU, demo.degreeV);
+    compareSurfaceDegrees("Clamped degree 2", demo, demoRuntime, samples);
+
+    BSplineSurface<3, 3> cubic = wavePatch(12);
+    RuntimeBSplineSurface cubicRuntime;
+    cubicRuntime.reset(cubic.controlPoints, cubic.countU, cubic.countV, cubic.knotsU, cubic.knotsV, 3, 3);
+    compareSurfaceDegrees("Uniform degree 3", cubic, cubicRuntime, samples);
+}
+
+// Time Per-Point Evaluation Against the Batch Kernels on Random Parameters Over a Uniform Cubic Patch
+void runBatchBenchmark() 
+{
+    const size_t count = 1000000;
+    BSplineSurface<3, 3> cubic = wavePatch(64);
+
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> parameter(cubic.knotsU[3], cubic.knotsU[cubic.countU]);
+    std::vector<float> u(count), v(count);
+    for (size_t i = 0; i < count; i++) 
+    {
+        u[i] = parameter(random);
+        v[i] = parameter(random);
+    }
+
+    std::vector<glm::vec3> reference(count);
+    Stopwatch pointTimer;
+    for (size_t i = 0; i < count; i++) reference[i] = cubic.evaluate(u[i], v[i]);
+    reportThroughput("Per point", count, pointTimer.seconds(), "samples");
 
-            glVertex3f(x1, y1, z1);
-            glVertex3f(x2, y2, z2);
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+    const char* names[] = { "Batch scalar", "Batch SSE2", "Batch AVX2" };
+    std::vector<float> x(count), y(count), z(count);
+    for (int level = 0; level < 3; level++) 
+    {
+        if (levels[level] > detectSimdLevel()) continue;
+        Stopwatch batchTimer;
+        evaluateSurfaceBatch(surfaceView(cubic), u.data(), v.data(), count, x.data(), y.data(), z.data(), levels[level]);
+        reportThroughput(names[level], count, batchTimer.seconds(), "samples");
 
-            glVertex3f(x1, y1, z1);
-            glVertex3f(x3, y3, z3);
+        float difference = 0.0f;
+        for (size_t i = 0; i < count; i++) 
+        {
+            glm::vec3 delta = glm::abs(glm::vec3(x[i], y[i], z[i]) - reference[i]);
+            difference = std::max(difference, std::max(delta.x, std::max(delta.y, delta.z)));
         }
+        std::cout << "    max difference " << difference << std::endl;
     }
-    glEnd();
+}
+
+// The Viewer's Surface and Sample Spacing; Edits Go Through the Functions Below, Whose Revisions Tell the
+// Tessellation What to Redo
+struct SplineScene 
+{
+    BSplineSurface<2, 2> surface = demoSurface();
+    float step = 0.05f;                          // Parameter Distance Between Tessellated Samples
+    uint64_t revision = 1;                       // Bumped by Every Edit
+    uint64_t samplingRevision = 1;               // Bumped When the Knots or Step Change the Basis Tables
+    bool filled = false;                         // Draw the Surface Under the Grid Lines; Display Only, No Revision
+};
+
+// Move One Control Point; the Basis Tables Stay Valid
+void moveControlPoint(SplineScene& scene, int column, int row, const glm::vec3& position) 
+{
+    scene.surface.controlPoints[size_t(row) * scene.surface.countU + column] = position;
+    scene.revision++;
+}
+
+// Change the Sample Spacing, Which Resamples Both Directions
+void setTessellationStep(SplineScene& scene, float step) 
+{
+    scene.step = std::clamp(step, 0.005f, 0.5f);
+    scene.revision++;
+    scene.samplingRevision++;
+}
+
+// Basis Tables Stay Valid While the Knots and Step Hold, So Control Point Edits Cost Only the Contraction
+struct Tessellation 
+{
+    uint64_t revision = 0, samplingRevision = 0;
+    BasisTable uTable, vTable;
+};
+
+// Re-Evaluate the Shared Vertex Grid Only When the Scene Was Edited, Rebuilding Tables Only for Knots or Step
+void updateBSplineGrid(SplineRenderer& renderer, const SplineScene& scene, Tessellation& tessellation) 
+{
+    if (tessellation.revision == scene.revision) return;
+
+    const BSplineSurface<2, 2>& surface = scene.surface;
+    if (tessellation.samplingRevision != scene.samplingRevision) 
+    {
+        size_t columns = static_cast<size_t>(std::ceil((surface.knotsU[surface.countU] - surface.knotsU[surface.degreeU]) / scene.step - 1e-4f)) + 1;
+        size_t rows = static_cast<size_t>(std::ceil((surface.knotsV[surface.countV] - surface.knotsV[surface.degreeV]) / scene.step - 1e-4f)) + 1;
+        buildUniformBasisTable(surface.knotsU.data(), surface.countU, surface.degreeU, columns, tessellation.uTable);
+        buildUniformBasisTable(surface.knotsV.data(), surface.countV, surface.degreeV, rows, tessellation.vTable);
+        tessellation.samplingRevision = scene.samplingRevision;
+    }
+
+    uint32_t columns = static_cast<uint32_t>(tessellation.uTable.sampleCount());
+    uint32_t rows = static_cast<uint32_t>(tessellation.vTable.sampleCount());
+    std::vector<glm::vec3> vertices(size_t(columns) * rows);
+    evaluateSurfaceGrid(tessellation.uTable, tessellation.vTable, surface.controlPoints.data(), surface.countU, vertices.data());
+    uploadSplineGrid(renderer, vertices.data(), columns, rows);
+    tessellation.revision = scene.revision;
+}
+
+// Up and Down Lift the Inner Control Point, Minus and Equals Coarsen and Refine the Tessellation, F Toggles the Fill
+void keyCallback(GLFWwindow* window, int key, int, int action, int) 
+{
+    if (action == GLFW_RELEASE) return;
+    SplineScene& scene = *static_cast<SplineScene*>(glfwGetWindowUserPointer(window));
+    glm::vec3 inner = scene.surface.controlPoints[size_t(scene.surface.countU) + 1];
+    if (key == GLFW_KEY_UP) moveControlPoint(scene, 1, 1, inner + glm::vec3(0.0f, 0.0f, 0.1f));
+    else if (key == GLFW_KEY_DOWN) moveControlPoint(scene, 1, 1, inner - glm::vec3(0.0f, 0.0f, 0.1f));
+    else if (key == GLFW_KEY_MINUS) setTessellationStep(scene, scene.step * 1.25f);
+    else if (key == GLFW_KEY_EQUAL) setTessellationStep(scene, scene.step / 1.25f);
+    else if (key == GLFW_KEY_F && action == GLFW_PRESS) scene.filled = !scene.filled;
 }
 
 // Orthographic Projection for Isometric View
-void setupProjection(int width, int height) 
+glm::mat4 projectionMatrix(int width, int height) 
 {
-    glViewport(0, 0, width, height);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
     float aspect = (float)width / (float)height;
     float scale = 4.0f;
-    glOrtho(-scale * aspect, scale * aspect, -scale, scale, -10.0f, 10.0f);
-
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    return glm::ortho(-scale * aspect, scale * aspect, -scale, scale, -10.0f, 10.0f);
 }
 
 // Camera Setup
-void setupCamera() 
+glm::mat4 cameraMatrix() 
 {
-    glLoadIdentity();
-    glTranslatef(0.0f, 0.0f, -cameraDistance);
-    glRotatef(rotationAngleX, 1.0f, 0.0f, 0.0f);
-    glRotatef(rotationAngleY, 0.0f, 1.0f, 0.0f);
-    glTranslatef(-1.5f, -1.0f, 0.0f);
+    glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -cameraDistance));
+    view = glm::rotate(view, glm::radians(rotationAngleX), glm::vec3(1.0f, 0.0f, 0.0f));
+    view = glm::rotate(view, glm::radians(rotationAngleY), glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::translate(view, glm::vec3(-1.5f, -1.0f, 0.0f));
 }
 
 // OpenGL/GLFW Setup
@@ -126,6 +353,11 @@ void setupOpenGL()
         return;
     }
 
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+
     GLFWwindow* window = glfwCreateWindow(1920, 1080, "Wireframe Render", NULL, NULL);
     if (!window) 
     {
@@ -135,24 +367,54 @@ void setupOpenGL()
     }
 
     glfwMakeContextCurrent(window);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) 
+    {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        return;
+    }
+
+    SplineRenderer renderer;
+    if (!createSplineRenderer(renderer)) 
+    {
+        glfwTerminate();
+        return;
+    }
+    SplineScene scene;
+    Tessellation tessellation;
+    glfwSetWindowUserPointer(window, &scene);
+    glfwSetKeyCallback(window, keyCallback);
 
-    setupProjection(1920, 1080);
+    glViewport(0, 0, 1920, 1080);
+    glEnable(GL_DEPTH_TEST);
+    glm::mat4 projection = projectionMatrix(1920, 1080);
 
     while (!glfwWindowShouldClose(window)) 
     {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        setupCamera();
-        renderBSplineWireframe();
+        updateBSplineGrid(renderer, scene, tessellation);
+        glm::mat4 mvp = projection * cameraMatrix();
+        if (scene.filled) drawSplineGrid(renderer, mvp, false);
+        drawSplineGrid(renderer, mvp);
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    destroySplineRenderer(renderer);
     glfwTerminate();
 }
 
-int main() 
+int main(int argc, char** argv) 
 {
+    // Basis Timing Without a Window: --bench
+    if (argc > 1 && std::string(argv[1]) == "--bench") 
+    {
+        runBasisBenchmark();
+        runSurfaceTemplateBenchmark();
+        runBatchBenchmark();
+        return 0;
+    }
+
     setupOpenGL();
     return 0;
 }
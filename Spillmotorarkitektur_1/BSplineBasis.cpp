@@ -0,0 +1,83 @@
+//sources
+// Piegl, Tiller - The NURBS Book, Algorithms A2.1 and A2.2 (1997)
+
+#include "BSplineBasis.h"
+
+#include <algorithm>
+
+int findKnotSpan(const float* knots, int controlCount, int degree, float u) 
+{
+    int last = controlCount - 1;
+    if (u >= knots[last + 1]) return last;
+    if (u <= knots[degree]) return degree;
+
+    // Last Knot at or Below u Among knots[degree..last]; Halving Without Branches, the Select Compiles to a Move
+    const float* base = knots + degree;
+    int remaining = last + 1 - degree;
+    while (remaining > 1) 
+    {
+        int half = remaining / 2;
+        base = base[half] <= u ? base + half : base;
+        remaining -= half;
+    }
+    return static_cast<int>(base - knots);
+}
+
+void basisFunctions(const float* knots, int span, int degree, float u, float* basis) 
+{
+    basisFunctions<runtimeDegree>(knots, span, degree, u, basis);
+}
+
+void buildBasisTable(const float* knots, int controlCount, int degree, const float* parameters, size_t count, BasisTable& table) 
+{
+    table.degree = degree;
+    table.firstControl.resize(count);
+    table.values.resize(count * (degree + 1));
+    for (size_t s = 0; s < count; s++) 
+    {
+        int span = findKnotSpan(knots, controlCount, degree, parameters[s]);
+        table.firstControl[s] = span - degree;
+        basisFunctions(knots, span, degree, parameters[s], &table.values[s * (degree + 1)]);
+    }
+}
+
+void buildUniformBasisTable(const float* knots, int controlCount, int degree, size_t samples, BasisTable& table) 
+{
+    float first = knots[degree], last = knots[controlCount];
+    std::vector<float> parameters(samples);
+    for (size_t s = 0; s < samples; s++) 
+    {
+        parameters[s] = samples > 1 ? std::min(first + (last - first) * s / (samples - 1), last) : first;
+    }
+    buildBasisTable(knots, controlCount, degree, parameters.data(), samples, table);
+}
+
+void evaluateSurfaceGrid(const BasisTable& uTable, const BasisTable& vTable, const glm::vec3* controlPoints, int countU, glm::vec3* out) 
+{
+    int orderU = uTable.degree + 1, orderV = vTable.degree + 1;
+    size_t columns = uTable.sampleCount();
+    std::vector<glm::vec3> curve(countU);
+
+    // Blend the Rows Into One Curve per v Sample, Then Sweep That Curve Along u
+    for (size_t row = 0; row < vTable.sampleCount(); row++) 
+    {
+        const float* Nv = &vTable.values[row * orderV];
+        const glm::vec3* block = controlPoints + size_t(vTable.firstControl[row]) * countU;
+        for (int i = 0; i < countU; i++) 
+        {
+            glm::vec3 sum(0.0f);
+            for (int l = 0; l < orderV; l++) sum += Nv[l] * block[size_t(l) * countU + i];
+            curve[i] = sum;
+        }
+
+        glm::vec3* target = out + row * columns;
+        for (size_t column = 0; column < columns; column++) 
+        {
+            const float* Nu = &uTable.values[column * orderU];
+            const glm::vec3* local = &curve[uTable.firstControl[column]];
+            glm::vec3 sum(0.0f);
+            for (int k = 0; k < orderU; k++) sum += Nu[k] * local[k];
+            target[column] = sum;
+        }
+    }
+}
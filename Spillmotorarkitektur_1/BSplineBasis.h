@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Largest Degree the Fixed-Size Basis Buffers Hold
+const int maxSplineDegree = 7;
+
+// Degree Template Argument Meaning the Degree Is Chosen at Runtime
+const int runtimeDegree = -1;
+
+// Basis Buffer Length for a Template Degree, the Largest Supported One When Chosen at Runtime
+template <int Degree>
+constexpr int basisOrder() 
+{
+    return Degree >= 0 ? Degree + 1 : maxSplineDegree + 1;
+}
+
+// Index of the Knot Span Holding u by Binary Search; u at or Past the Last Knot Maps to the Last Non-Empty Span
+int findKnotSpan(const float* knots, int controlCount, int degree, float u);
+
+// The degree + 1 Basis Functions Nonzero on span, Without Recursion; basis[k] Weights Control Point span - degree + k.
+// A Fixed Degree Gives the Loops Compile-Time Trip Counts, runtimeDegree Reads degree Instead
+template <int Degree>
+inline void basisFunctions(const float* knots, int span, int degree, float u, float* basis) 
+{
+    const int top = Degree >= 0 ? Degree : degree;
+    float left[basisOrder<Degree>()], right[basisOrder<Degree>()];
+    basis[0] = 1.0f;
+
+    // Raise the Degree One Step at a Time, Each Level Reusing the Previous Level's Values
+    for (int j = 1; j <= top; j++) 
+    {
+        left[j] = u - knots[span + 1 - j];
+        right[j] = knots[span + j] - u;
+        float saved = 0.0f;
+        for (int r = 0; r < j; r++) 
+        {
+            float term = basis[r] / (right[r + 1] + left[j - r]);
+            basis[r] = saved + right[r + 1] * term;
+            saved = left[j - r] * term;
+        }
+        basis[j] = saved;
+    }
+}
+
+// Degree Chosen at Runtime
+void basisFunctions(const float* knots, int span, int degree, float u, float* basis);
+
+// Spans and Nonzero Basis Values for Fixed Parameter Samples Along One Direction; Depends Only on the Knots, So One
+// Table Serves Every Surface Sharing Them
+struct BasisTable 
+{
+    int degree = 0;
+    std::vector<int> firstControl;               // Per Sample, Index of the Control Point Weighted by values[0]
+    std::vector<float> values;                   // degree + 1 per Sample
+
+    size_t sampleCount() const { return firstControl.size(); }
+};
+
+// Tabulate the Basis at Each Parameter
+void buildBasisTable(const float* knots, int controlCount, int degree, const float* parameters, size_t count, BasisTable& table);
+
+// Tabulate samples Evenly Spaced Parameters From the First to the Last Valid Knot, Both Ends Included
+void buildUniformBasisTable(const float* knots, int controlCount, int degree, size_t samples, BasisTable& table);
+
+// Evaluate Every (u, v) Sample Pair; controlPoints Is Row-Major With countU Points per Row Along u, Rows Along v;
+// out[row * uTable.sampleCount() + column]
+void evaluateSurfaceGrid(const BasisTable& uTable, const BasisTable& vTable, const glm::vec3* controlPoints, int countU, glm::vec3* out);
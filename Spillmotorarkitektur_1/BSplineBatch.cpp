@@ -0,0 +1,285 @@
+#include "BSplineBatch.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace 
+{
+    // Samples Sharing One (spanU, spanV) Pair, at [first, first + count) of the Span-Sorted Arrays
+    struct SpanGroup 
+    {
+        int spanU, spanV;
+        size_t first, count;
+    };
+
+    // Row-Major Index of the Span Pair Holding (u, v), Both Already Clamped
+    uint32_t spanKey(const SurfaceView& s, float u, float v) 
+    {
+        int spanU = findKnotSpan(s.knotsU, s.countU, s.degreeU, u);
+        int spanV = findKnotSpan(s.knotsV, s.countV, s.degreeV, v);
+        return static_cast<uint32_t>((spanV - s.degreeV) * (s.countU - s.degreeU) + (spanU - s.degreeU));
+    }
+
+    void evaluateGroupScalar(const SurfaceView& s, const SpanGroup& group, const float* u, const float* v, float* x, float* y, float* z) 
+    {
+        float Nu[maxSplineDegree + 1], Nv[maxSplineDegree + 1];
+        const glm::vec3* block = s.controlPoints + size_t(group.spanV - s.degreeV) * s.countU + (group.spanU - s.degreeU);
+        for (size_t i = group.first; i < group.first + group.count; i++) 
+        {
+            basisFunctions(s.knotsU, group.spanU, s.degreeU, u[i], Nu);
+            basisFunctions(s.knotsV, group.spanV, s.degreeV, v[i], Nv);
+            glm::vec3 point(0.0f);
+            for (int l = 0; l <= s.degreeV; l++) 
+            {
+                glm::vec3 sum(0.0f);
+                for (int k = 0; k <= s.degreeU; k++) sum += Nu[k] * block[size_t(l) * s.countU + k];
+                point += Nv[l] * sum;
+            }
+            x[i] = point.x;
+            y[i] = point.y;
+            z[i] = point.z;
+        }
+    }
+
+#ifdef SIMD_SSE2
+    // basisFunctions Across 4 Lanes; Every Lane Lies in the Same Span, So the Knots Are Broadcast
+    void basisSse2(const float* knots, int span, int degree, __m128 u, __m128* basis) 
+    {
+        __m128 left[maxSplineDegree + 1], right[maxSplineDegree + 1];
+        basis[0] = _mm_set1_ps(1.0f);
+        for (int j = 1; j <= degree; j++) 
+        {
+            left[j] = _mm_sub_ps(u, _mm_set1_ps(knots[span + 1 - j]));
+            right[j] = _mm_sub_ps(_mm_set1_ps(knots[span + j]), u);
+            __m128 saved = _mm_setzero_ps();
+            for (int r = 0; r < j; r++) 
+            {
+                __m128 term = _mm_div_ps(basis[r], _mm_add_ps(right[r + 1], left[j - r]));
+                basis[r] = _mm_add_ps(saved, _mm_mul_ps(right[r + 1], term));
+                saved = _mm_mul_ps(left[j - r], term);
+            }
+            basis[j] = saved;
+        }
+    }
+
+    void evaluateGroupSse2(const SurfaceView& s, const SpanGroup& group, const float* u, const float* v, float* x, float* y, float* z) 
+    {
+        int orderU = s.degreeU + 1, orderV = s.degreeV + 1;
+        const glm::vec3* block = s.controlPoints + size_t(group.spanV - s.degreeV) * s.countU + (group.spanU - s.degreeU);
+        __m128 points[3 * (maxSplineDegree + 1) * (maxSplineDegree + 1)];
+        for (int l = 0; l < orderV; l++) 
+        {
+            for (int k = 0; k < orderU; k++) 
+            {
+                const glm::vec3& p = block[size_t(l) * s.countU + k];
+                __m128* target = &points[3 * (l * orderU + k)];
+                target[0] = _mm_set1_ps(p.x);
+                target[1] = _mm_set1_ps(p.y);
+                target[2] = _mm_set1_ps(p.z);
+            }
+        }
+
+        // A Short Final Chunk Reads Into the Next Group and Its Extra Lanes Are Overwritten Later; Padding Past the
+        // Last Group Keeps Those Reads in Bounds
+        for (size_t i = group.first; i < group.first + group.count; i += 4) 
+        {
+            __m128 Nu[maxSplineDegree + 1], Nv[maxSplineDegree + 1];
+            basisSse2(s.knotsU, group.spanU, s.degreeU, _mm_loadu_ps(u + i), Nu);
+            basisSse2(s.knotsV, group.spanV, s.degreeV, _mm_loadu_ps(v + i), Nv);
+            __m128 px = _mm_setzero_ps(), py = _mm_setzero_ps(), pz = _mm_setzero_ps();
+            for (int l = 0; l < orderV; l++) 
+            {
+                __m128 rx = _mm_setzero_ps(), ry = _mm_setzero_ps(), rz = _mm_setzero_ps();
+                for (int k = 0; k < orderU; k++) 
+                {
+                    const __m128* p = &points[3 * (l * orderU + k)];
+                    rx = _mm_add_ps(rx, _mm_mul_ps(Nu[k], p[0]));
+                    ry = _mm_add_ps(ry, _mm_mul_ps(Nu[k], p[1]));
+                    rz = _mm_add_ps(rz, _mm_mul_ps(Nu[k], p[2]));
+                }
+                px = _mm_add_ps(px, _mm_mul_ps(Nv[l], rx));
+                py = _mm_add_ps(py, _mm_mul_ps(Nv[l], ry));
+                pz = _mm_add_ps(pz, _mm_mul_ps(Nv[l], rz));
+            }
+            _mm_storeu_ps(x + i, px);
+            _mm_storeu_ps(y + i, py);
+            _mm_storeu_ps(z + i, pz);
+        }
+    }
+#endif
+
+#ifdef SIMD_AVX2
+    // findKnotSpan for 8 Parameters, Relative to the First Valid Span; Every Lane Halves the Same Range, So the Loop
+    // Is Shared and Each Step Is One Gather
+    SIMD_TARGET_AVX2 __m256i spanOffsetsAvx2(const float* knots, int count, int degree, __m256 u) 
+    {
+        __m256i base = _mm256_setzero_si256();
+        for (int remaining = count - degree; remaining > 1;) 
+        {
+            int half = remaining / 2;
+            __m256i step = _mm256_set1_epi32(half);
+            __m256 knot = _mm256_i32gather_ps(knots + degree, _mm256_add_epi32(base, step), 4);
+            __m256i below = _mm256_castps_si256(_mm256_cmp_ps(knot, u, _CMP_LE_OQ));
+            base = _mm256_add_epi32(base, _mm256_and_si256(below, step));
+            remaining -= half;
+        }
+        return base;
+    }
+
+    // Span Keys 8 at a Time, Also Storing the Clamped Parameters; Returns How Many Were Done
+    SIMD_TARGET_AVX2 size_t spanKeysAvx2(const SurfaceView& s, const float* u, const float* v, size_t count, float* clampedU, float* clampedV, uint32_t* keys) 
+    {
+        __m256 minU = _mm256_set1_ps(s.knotsU[s.degreeU]), maxU = _mm256_set1_ps(s.knotsU[s.countU]);
+        __m256 minV = _mm256_set1_ps(s.knotsV[s.degreeV]), maxV = _mm256_set1_ps(s.knotsV[s.countV]);
+        __m256i spansU = _mm256_set1_epi32(s.countU - s.degreeU);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) 
+        {
+            __m256 pu = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(u + i), minU), maxU);
+            __m256 pv = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(v + i), minV), maxV);
+            _mm256_storeu_ps(clampedU + i, pu);
+            _mm256_storeu_ps(clampedV + i, pv);
+            __m256i offsetU = spanOffsetsAvx2(s.knotsU, s.countU, s.degreeU, pu);
+            __m256i offsetV = spanOffsetsAvx2(s.knotsV, s.countV, s.degreeV, pv);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + i), _mm256_add_epi32(_mm256_mullo_epi32(offsetV, spansU), offsetU));
+        }
+        return i;
+    }
+
+    SIMD_TARGET_AVX2 void basisAvx2(const float* knots, int span, int degree, __m256 u, __m256* basis) 
+    {
+        __m256 left[maxSplineDegree + 1], right[maxSplineDegree + 1];
+        basis[0] = _mm256_set1_ps(1.0f);
+        for (int j = 1; j <= degree; j++) 
+        {
+            left[j] = _mm256_sub_ps(u, _mm256_set1_ps(knots[span + 1 - j]));
+            right[j] = _mm256_sub_ps(_mm256_set1_ps(knots[span + j]), u);
+            __m256 saved = _mm256_setzero_ps();
+            for (int r = 0; r < j; r++) 
+            {
+                __m256 term = _mm256_div_ps(basis[r], _mm256_add_ps(right[r + 1], left[j - r]));
+                basis[r] = _mm256_fmadd_ps(right[r + 1], term, saved);
+                saved = _mm256_mul_ps(left[j - r], term);
+            }
+            basis[j] = saved;
+        }
+    }
+
+    SIMD_TARGET_AVX2 void evaluateGroupAvx2(const SurfaceView& s, const SpanGroup& group, const float* u, const float* v, float* x, float* y, float* z) 
+    {
+        int orderU = s.degreeU + 1, orderV = s.degreeV + 1;
+        const glm::vec3* block = s.controlPoints + size_t(group.spanV - s.degreeV) * s.countU + (group.spanU - s.degreeU);
+        __m256 points[3 * (maxSplineDegree + 1) * (maxSplineDegree + 1)];
+        for (int l = 0; l < orderV; l++) 
+        {
+            for (int k = 0; k < orderU; k++) 
+            {
+                const glm::vec3& p = block[size_t(l) * s.countU + k];
+                __m256* target = &points[3 * (l * orderU + k)];
+                target[0] = _mm256_set1_ps(p.x);
+                target[1] = _mm256_set1_ps(p.y);
+                target[2] = _mm256_set1_ps(p.z);
+            }
+        }
+
+        for (size_t i = group.first; i < group.first + group.count; i += 8) 
+        {
+            __m256 Nu[maxSplineDegree + 1], Nv[maxSplineDegree + 1];
+            basisAvx2(s.knotsU, group.spanU, s.degreeU, _mm256_loadu_ps(u + i), Nu);
+            basisAvx2(s.knotsV, group.spanV, s.degreeV, _mm256_loadu_ps(v + i), Nv);
+            __m256 px = _mm256_setzero_ps(), py = _mm256_setzero_ps(), pz = _mm256_setzero_ps();
+            for (int l = 0; l < orderV; l++) 
+            {
+                __m256 rx = _mm256_setzero_ps(), ry = _mm256_setzero_ps(), rz = _mm256_setzero_ps();
+                for (int k = 0; k < orderU; k++) 
+                {
+                    const __m256* p = &points[3 * (l * orderU + k)];
+                    rx = _mm256_fmadd_ps(Nu[k], p[0], rx);
+                    ry = _mm256_fmadd_ps(Nu[k], p[1], ry);
+                    rz = _mm256_fmadd_ps(Nu[k], p[2], rz);
+                }
+                px = _mm256_fmadd_ps(Nv[l], rx, px);
+                py = _mm256_fmadd_ps(Nv[l], ry, py);
+                pz = _mm256_fmadd_ps(Nv[l], rz, pz);
+            }
+            _mm256_storeu_ps(x + i, px);
+            _mm256_storeu_ps(y + i, py);
+            _mm256_storeu_ps(z + i, pz);
+        }
+    }
+#endif
+}
+
+void evaluateSurfaceBatch(const SurfaceView& surface, const float* u, const float* v, size_t count, float* x, float* y, float* z, SimdLevel level) 
+{
+    // Blocks Keep the Sort's Scattered Writes in Cache While Still Holding Several Samples per Span Pair on Average
+    const size_t padding = 8;
+    size_t spanPairs = size_t(surface.countU - surface.degreeU) * (surface.countV - surface.degreeV);
+    size_t block = std::min(count, std::max<size_t>(65536, 4 * spanPairs));
+    float minU = surface.knotsU[surface.degreeU], maxU = surface.knotsU[surface.countU];
+    float minV = surface.knotsV[surface.degreeV], maxV = surface.knotsV[surface.countV];
+
+    std::vector<uint32_t> keys(block), order(block), offsets(spanPairs + 1), next(spanPairs);
+    std::vector<float> clampedU(block), clampedV(block);
+    std::vector<float> sortedU(block + padding, minU), sortedV(block + padding, minV);
+    std::vector<float> sortedX(block + padding), sortedY(block + padding), sortedZ(block + padding);
+    for (size_t start = 0; start < count; start += block) 
+    {
+        size_t samples = std::min(block, count - start);
+        size_t done = 0;
+#ifdef SIMD_AVX2
+        if (level == SimdLevel::Avx2) done = spanKeysAvx2(surface, u + start, v + start, samples, clampedU.data(), clampedV.data(), keys.data());
+#endif
+        for (size_t i = done; i < samples; i++) 
+        {
+            clampedU[i] = std::clamp(u[start + i], minU, maxU);
+            clampedV[i] = std::clamp(v[start + i], minV, maxV);
+            keys[i] = spanKey(surface, clampedU[i], clampedV[i]);
+        }
+
+        // Counting Sort by Span Pair, Carrying the Parameters Into Contiguous Runs
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (size_t i = 0; i < samples; i++) offsets[keys[i] + 1]++;
+        for (size_t k = 1; k < offsets.size(); k++) offsets[k] += offsets[k - 1];
+        std::copy(offsets.begin(), offsets.end() - 1, next.begin());
+        for (size_t i = 0; i < samples; i++) 
+        {
+            uint32_t slot = next[keys[i]]++;
+            order[slot] = static_cast<uint32_t>(i);
+            sortedU[slot] = clampedU[i];
+            sortedV[slot] = clampedV[i];
+        }
+        std::fill(sortedU.begin() + samples, sortedU.end(), minU);
+        std::fill(sortedV.begin() + samples, sortedV.end(), minV);
+
+        int spansU = surface.countU - surface.degreeU;
+        for (size_t key = 0; key < spanPairs; key++) 
+        {
+            if (offsets[key + 1] == offsets[key]) continue;
+            SpanGroup group = { static_cast<int>(key % spansU) + surface.degreeU, static_cast<int>(key / spansU) + surface.degreeV, offsets[key], offsets[key + 1] - offsets[key] };
+#ifdef SIMD_AVX2
+            if (level == SimdLevel::Avx2) 
+            {
+                evaluateGroupAvx2(surface, group, sortedU.data(), sortedV.data(), sortedX.data(), sortedY.data(), sortedZ.data());
+                continue;
+            }
+#endif
+#ifdef SIMD_SSE2
+            if (level != SimdLevel::Scalar) 
+            {
+                evaluateGroupSse2(surface, group, sortedU.data(), sortedV.data(), sortedX.data(), sortedY.data(), sortedZ.data());
+                continue;
+            }
+#endif
+            evaluateGroupScalar(surface, group, sortedU.data(), sortedV.data(), sortedX.data(), sortedY.data(), sortedZ.data());
+        }
+
+        for (size_t slot = 0; slot < samples; slot++) 
+        {
+            size_t sample = start + order[slot];
+            x[sample] = sortedX[slot];
+            y[sample] = sortedY[slot];
+            z[sample] = sortedZ[slot];
+        }
+    }
+}
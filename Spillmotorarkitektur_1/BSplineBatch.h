@@ -0,0 +1,26 @@
+#pragma once
+
+#include "BSplineSurface.h"
+#include "Simd.h"
+
+#include <cstddef>
+
+// Surface Data the Batch Kernels Read, Borrowed From a BSplineSurface That Must Outlive It
+struct SurfaceView 
+{
+    const glm::vec3* controlPoints = nullptr;
+    const float* knotsU = nullptr;
+    const float* knotsV = nullptr;
+    int countU = 0, countV = 0;
+    int degreeU = 0, degreeV = 0;
+};
+
+template <int DegreeU, int DegreeV>
+SurfaceView surfaceView(const BSplineSurface<DegreeU, DegreeV>& surface) 
+{
+    return { surface.controlPoints.data(), surface.knotsU.data(), surface.knotsV.data(), surface.countU, surface.countV, surface.degreeU, surface.degreeV };
+}
+
+// Evaluate count (u, v) Pairs Into Separate x, y and z Arrays; Samples Are Grouped by Knot Span Pair So Each Control
+// Point Block Is Loaded Once per Group, Then Run 8 (AVX2) or 4 (SSE2) Samples per Instruction
+void evaluateSurfaceBatch(const SurfaceView& surface, const float* u, const float* v, size_t count, float* x, float* y, float* z, SimdLevel level = detectSimdLevel());
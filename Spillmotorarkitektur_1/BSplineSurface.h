@@ -0,0 +1,156 @@
+//sources
+// Qin - General Matrix Representations for B-Splines (2000)
+
+#pragma once
+
+#include "BSplineBasis.h"
+
+#include <glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Uniform B-Spline Basis as Polynomials in the Local Span Parameter t: basis[k] = sum over j of t^j * matrix[j][k]
+template <int Degree>
+constexpr std::array<std::array<float, Degree + 1>, Degree + 1> uniformBasisMatrix() 
+{
+    std::array<std::array<double, Degree + 2>, Degree + 2> binomial = {};
+    for (int n = 0; n <= Degree + 1; n++) 
+    {
+        binomial[n][0] = 1.0;
+        for (int k = 1; k <= n; k++) binomial[n][k] = binomial[n - 1][k - 1] + (k <= n - 1 ? binomial[n - 1][k] : 0.0);
+    }
+    double factorial = 1.0;
+    for (int n = 2; n <= Degree; n++) factorial *= n;
+
+    std::array<std::array<float, Degree + 1>, Degree + 1> matrix = {};
+    for (int j = 0; j <= Degree; j++) 
+    {
+        for (int k = 0; k <= Degree; k++) 
+        {
+            double sum = 0.0;
+            for (int s = k; s <= Degree; s++) 
+            {
+                double power = 1.0;
+                for (int e = 0; e < Degree - j; e++) power *= Degree - s;
+                sum += ((s - k) % 2 == 0 ? 1.0 : -1.0) * binomial[Degree + 1][s - k] * power;
+            }
+            matrix[j][k] = static_cast<float>(binomial[Degree][j] * sum / factorial);
+        }
+    }
+    return matrix;
+}
+
+// Basis Along One Direction, Returns the First Contributing Control Point; Spans With Evenly Spaced Knots Around Them
+// Use the Precomputed Uniform Matrix
+template <int Degree>
+inline int directionBasis(const std::vector<float>& knots, const std::vector<uint8_t>& uniform, int count, int degree, float u, float* basis) 
+{
+    if constexpr (Degree >= 0) 
+    {
+        int span = findKnotSpan(knots.data(), count, Degree, u);
+        if (uniform[span]) 
+        {
+            static constexpr std::array<std::array<float, Degree + 1>, Degree + 1> matrix = uniformBasisMatrix<Degree>();
+            float t = (u - knots[span]) / (knots[span + 1] - knots[span]);
+            for (int k = 0; k <= Degree; k++) 
+            {
+                float value = matrix[Degree][k];
+                for (int j = Degree - 1; j >= 0; j--) value = value * t + matrix[j][k];
+                basis[k] = value;
+            }
+        }
+        else basisFunctions<Degree>(knots.data(), span, Degree, u, basis);
+        return span - Degree;
+    }
+    else 
+    {
+        int span = findKnotSpan(knots.data(), count, degree, u);
+        basisFunctions(knots.data(), span, degree, u, basis);
+        return span - degree;
+    }
+}
+
+// Tensor-Product B-Spline Surface of Any Grid Size; Degrees Fixed at Compile Time Unless Given as runtimeDegree
+template <int DegreeU, int DegreeV>
+struct BSplineSurface 
+{
+    int degreeU = DegreeU, degreeV = DegreeV;
+    int countU = 0, countV = 0;
+    std::vector<glm::vec3> controlPoints;        // Row-Major, countU Points per Row Along u, Rows Along v
+    std::vector<float> knotsU, knotsV;
+    std::vector<uint8_t> uniformU, uniformV;     // Per Span, Whether the Knots the Basis Reads Are Evenly Spaced
+
+    // Take a Control Grid and Knots; Degrees Are Read Only for runtimeDegree Directions
+    bool reset(std::vector<glm::vec3> points, int columns, int rows, std::vector<float> u, std::vector<float> v, int runtimeU = DegreeU, int runtimeV = DegreeV) 
+    {
+        int pu = DegreeU >= 0 ? DegreeU : runtimeU, pv = DegreeV >= 0 ? DegreeV : runtimeV;
+        if (pu < 1 || pv < 1 || pu > maxSplineDegree || pv > maxSplineDegree || columns <= pu || rows <= pv) 
+        {
+            std::cerr << "Failed to create B-spline surface: unsupported degree or too few control points" << std::endl;
+            return false;
+        }
+        if (points.size() != size_t(columns) * rows || u.size() != size_t(columns + pu + 1) || v.size() != size_t(rows + pv + 1)) 
+        {
+            std::cerr << "Failed to create B-spline surface: control grid and knot vectors do not match" << std::endl;
+            return false;
+        }
+
+        degreeU = pu;
+        degreeV = pv;
+        countU = columns;
+        countV = rows;
+        controlPoints = std::move(points);
+        knotsU = std::move(u);
+        knotsV = std::move(v);
+        uniformU = uniformSpans(knotsU, degreeU);
+        uniformV = uniformSpans(knotsV, degreeV);
+        return true;
+    }
+
+    // Surface Point; Parameters Are Clamped Into the Valid Knot Range
+    glm::vec3 evaluate(float u, float v) const 
+    {
+        float Nu[basisOrder<DegreeU>()], Nv[basisOrder<DegreeV>()];
+        u = std::clamp(u, knotsU[degreeU], knotsU[countU]);
+        v = std::clamp(v, knotsV[degreeV], knotsV[countV]);
+        int firstU = directionBasis<DegreeU>(knotsU, uniformU, countU, degreeU, u, Nu);
+        int firstV = directionBasis<DegreeV>(knotsV, uniformV, countV, degreeV, v, Nv);
+
+        int orderU = DegreeU >= 0 ? DegreeU + 1 : degreeU + 1;
+        int orderV = DegreeV >= 0 ? DegreeV + 1 : degreeV + 1;
+        glm::vec3 point(0.0f);
+        for (int l = 0; l < orderV; l++) 
+        {
+            const glm::vec3* row = &controlPoints[size_t(firstV + l) * countU + firstU];
+            glm::vec3 sum(0.0f);
+            for (int k = 0; k < orderU; k++) sum += Nu[k] * row[k];
+            point += Nv[l] * sum;
+        }
+        return point;
+    }
+
+    // Spans Whose 2 * degree Surrounding Knots Are Evenly Spaced; Only Fixed Degrees Have a Matrix to Use
+    static std::vector<uint8_t> uniformSpans(const std::vector<float>& knots, int degree) 
+    {
+        std::vector<uint8_t> uniform(knots.size(), 0);
+        for (int span = degree; span + degree < static_cast<int>(knots.size()); span++) 
+        {
+            float spacing = knots[span + 1] - knots[span];
+            bool even = spacing > 0.0f;
+            for (int k = span + 1 - degree; even && k < span + degree; k++) 
+            {
+                even = std::fabs(knots[k + 1] - knots[k] - spacing) <= 1e-6f * spacing;
+            }
+            uniform[span] = even;
+        }
+        return uniform;
+    }
+};
+
+// Degrees Chosen at Runtime, for Degrees Without a Specialization
+using RuntimeBSplineSurface = BSplineSurface<runtimeDegree, runtimeDegree>;
@@ -0,0 +1,224 @@
+#include "Benchmarks.h"
+#include "Delaunay.h"
+#include "LasReader.h"
+#include "MortonSort.h"
+#include "PointRenderer.h"
+#include "Profiling.h"
+#include "SpatialGrid.h"
+#include "SurfaceQueries.h"
+#include "TerrainLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace 
+{
+    const int renderFrames = 20;
+    const size_t queryCount = 2000;
+    const size_t queryPointsPerSlice = 4096;
+    const size_t gridBatch = 100000;
+
+    bool overlaps(const Bounds& a, const Bounds& b) 
+    {
+        return a.minX <= b.maxX && a.maxX >= b.minX && a.minY <= b.maxY && a.maxY >= b.minY;
+    }
+
+    bool contains(const Bounds& box, const Bounds& b) 
+    {
+        return b.minX >= box.minX && b.maxX <= box.maxX && b.minY >= box.minY && b.maxY <= box.maxY;
+    }
+
+    // Count Points Inside an XY Box, Skipping Slices Whose Bounds Miss It
+    size_t countInBox(const std::vector<Point>& points, const std::vector<PointSlice>& slices, const Bounds& box, size_t& scanned) 
+    {
+        size_t inside = 0;
+        for (const PointSlice& slice : slices) 
+        {
+            if (!overlaps(slice.bounds, box)) continue;
+            if (contains(box, slice.bounds)) 
+            {
+                inside += slice.count;
+                continue;
+            }
+            scanned += slice.count;
+            for (size_t i = slice.first; i < slice.first + slice.count; i++) 
+            {
+                const Point& p = points[i];
+                inside += p.x >= box.minX && p.x <= box.maxX && p.y >= box.minY && p.y <= box.maxY;
+            }
+        }
+        return inside;
+    }
+
+    // Boxes Covering About 1% of the Footprint, the Same Set for Both Orders
+    std::vector<Bounds> queryBoxes(const Bounds& bounds) 
+    {
+        std::mt19937 random(7);
+        float width = (bounds.maxX - bounds.minX) * 0.1f, depth = (bounds.maxY - bounds.minY) * 0.1f;
+        std::uniform_real_distribution<float> pickX(bounds.minX, bounds.maxX - width);
+        std::uniform_real_distribution<float> pickY(bounds.minY, bounds.maxY - depth);
+        std::vector<Bounds> boxes(queryCount);
+        for (Bounds& box : boxes) 
+        {
+            float x = pickX(random), y = pickY(random);
+            box = { x, y, bounds.minZ, x + width, y + depth, bounds.maxZ };
+        }
+        return boxes;
+    }
+
+    bool loadBenchmarkPoints(const std::string& filename, std::vector<Point>& points, PointAttributes& attributes, Bounds& bounds) 
+    {
+        bounds = emptyBounds();
+        if (isLasFile(filename)) loadLasData(filename, points, attributes, &bounds);
+        else points = loadTerrainData(filename, &bounds);
+        if (points.empty()) std::cerr << "No Points Loaded" << std::endl;
+        return !points.empty();
+    }
+
+    void benchmarkOrder(const char* label, const std::vector<Point>& points, const Bounds& bounds) 
+    {
+        // Draw the Whole Cloud Top Down, Waiting for the GPU Each Frame
+        PointRenderer renderer;
+        if (createPointRenderer(renderer, points.data(), points.size())) 
+        {
+            glm::mat4 mvp = normalizationMatrix(bounds);
+            drawPoints(renderer, mvp);
+            glFinish();
+            Stopwatch timer;
+            for (int frame = 0; frame < renderFrames; frame++) 
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                drawPoints(renderer, mvp);
+                glFinish();
+            }
+            std::cout << label << " render: " << timer.seconds() * 1000.0 / renderFrames << " ms per frame" << std::endl;
+            destroyPointRenderer(renderer);
+        }
+
+        std::vector<PointSlice> slices = slicePoints(points.data(), points.size(), queryPointsPerSlice);
+        std::vector<Bounds> boxes = queryBoxes(bounds);
+        size_t found = 0, scanned = 0;
+        Stopwatch timer;
+        for (const Bounds& box : boxes) found += countInBox(points, slices, box, scanned);
+        double seconds = timer.seconds();
+        std::cout << label << " range query: " << seconds * 1000000.0 / boxes.size() << " us per box, " << found
+                  << " points found, " << scanned << " scanned" << std::endl;
+    }
+}
+
+bool runMortonBenchmark(const std::string& filename) 
+{
+    std::vector<Point> points;
+    PointAttributes attributes;
+    Bounds bounds;
+    if (!loadBenchmarkPoints(filename, points, attributes, bounds)) return false;
+
+    benchmarkOrder("File order", points, bounds);
+
+    Stopwatch timer;
+    sortPointsMorton(points, attributes, bounds);
+    reportThroughput("Morton sort", points.size(), timer.seconds());
+
+    benchmarkOrder("Morton order", points, bounds);
+    return true;
+}
+
+bool runQueryBenchmark(const std::string& filename) 
+{
+    std::vector<Point> points;
+    PointAttributes attributes;
+    Bounds bounds;
+    if (!loadBenchmarkPoints(filename, points, attributes, bounds)) return false;
+
+    Stopwatch timer;
+    SpatialGrid grid;
+    buildSpatialGrid(points.data(), points.size(), grid);
+    reportThroughput("Spatial grid build", points.size(), timer.seconds());
+    std::cout << "Grid " << grid.columns << " x " << grid.rows << " cells of " << grid.cellSize << std::endl;
+
+    // Uniform Positions Over the Footprint, Radii and Boxes Sized to a Few Cells
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> pickX(bounds.minX, bounds.maxX), pickY(bounds.minY, bounds.maxY);
+    std::vector<PlanePoint> queries(gridBatch);
+    for (PlanePoint& q : queries) q = { pickX(random), pickY(random) };
+    float radius = grid.cellSize * 2.0f;
+    std::vector<Bounds> boxes(gridBatch);
+    for (size_t i = 0; i < gridBatch; i++) 
+    {
+        boxes[i] = { queries[i].x, queries[i].y, bounds.minZ, queries[i].x + radius, queries[i].y + radius, bounds.maxZ };
+    }
+
+    const int k = 8;
+    std::vector<uint32_t> nearest(gridBatch * k), indices;
+    std::vector<size_t> offsets;
+    std::vector<float> heights(gridBatch);
+
+    timer = Stopwatch();
+    nearestBatch(grid, queries.data(), gridBatch, radius * 4.0f, nearest.data());
+    reportThroughput("Nearest neighbour", gridBatch, timer.seconds(), "queries");
+
+    timer = Stopwatch();
+    nearestKBatch(grid, queries.data(), gridBatch, k, radius * 4.0f, nearest.data());
+    reportThroughput("8 nearest neighbours", gridBatch, timer.seconds(), "queries");
+
+    timer = Stopwatch();
+    size_t hits = radiusBatch(grid, queries.data(), gridBatch, radius, offsets, indices);
+    reportThroughput("Radius", gridBatch, timer.seconds(), "queries");
+    std::cout << "  " << hits << " points within radius " << radius << std::endl;
+
+    timer = Stopwatch();
+    hits = boxBatch(grid, boxes.data(), gridBatch, offsets, indices);
+    reportThroughput("Box", gridBatch, timer.seconds(), "queries");
+    std::cout << "  " << hits << " points in boxes" << std::endl;
+
+    timer = Stopwatch();
+    heightAtBatch(grid, queries.data(), gridBatch, radius * 4.0f, heights.data());
+    reportThroughput("Height at", gridBatch, timer.seconds(), "queries");
+    return true;
+}
+
+bool runSurfaceBenchmark(const std::string& filename) 
+{
+    std::vector<Point> points;
+    PointAttributes attributes;
+    Bounds bounds;
+    if (!loadBenchmarkPoints(filename, points, attributes, bounds)) return false;
+
+    TerrainMesh mesh;
+    if (!triangulatePoints(points.data(), points.size(), mesh)) return false;
+    Stopwatch timer;
+    TriangleGrid grid;
+    if (!buildTriangleGrid(mesh, grid)) return false;
+    reportThroughput("Triangle grid build", mesh.triangleCount(), timer.seconds(), "triangles");
+
+    // Objects Scattered Over the Footprint, Each Drifting a Fraction of a Triangle per Frame
+    std::mt19937 random(13);
+    std::uniform_real_distribution<float> pickX(bounds.minX, bounds.maxX), pickY(bounds.minY, bounds.maxY);
+    std::uniform_real_distribution<float> drift(-1.0f, 1.0f);
+    float step = std::sqrt((bounds.maxX - bounds.minX) * (bounds.maxY - bounds.minY) / std::max<size_t>(mesh.triangleCount(), 1));
+    std::vector<PlanePoint> queries(gridBatch);
+    for (PlanePoint& q : queries) q = { pickX(random), pickY(random) };
+    std::vector<SurfaceSample> samples(gridBatch);
+    for (SurfaceSample& sample : samples) sample.triangle = noTriangle;
+
+    timer = Stopwatch();
+    sampleSurfaceBatch(mesh, grid, queries.data(), gridBatch, samples.data());
+    reportThroughput("Surface samples, grid only", gridBatch, timer.seconds(), "queries");
+
+    for (PlanePoint& q : queries) 
+    {
+        q.x = std::min(std::max(q.x + drift(random) * step, bounds.minX), bounds.maxX);
+        q.y = std::min(std::max(q.y + drift(random) * step, bounds.minY), bounds.maxY);
+    }
+    timer = Stopwatch();
+    sampleSurfaceBatch(mesh, grid, queries.data(), gridBatch, samples.data());
+    reportThroughput("Surface samples, previous frame hint", gridBatch, timer.seconds(), "queries");
+
+    size_t missed = 0;
+    for (const SurfaceSample& sample : samples) missed += sample.triangle == noTriangle;
+    std::cout << "  " << missed << " queries off the mesh" << std::endl;
+    return true;
+}
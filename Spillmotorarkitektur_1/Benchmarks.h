@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Time Rendering and Box Queries on File Order, Then on Morton Order; Needs a Current GL Context
+bool runMortonBenchmark(const std::string& filename);
+
+// Build the XY Spatial Grid and Time Batches of Nearest, k-Nearest, Radius, Box and Height Queries
+bool runQueryBenchmark(const std::string& filename);
+
+// Triangulate, Then Time Batches of Height and Normal Samples Without and With Previous-Frame Hints
+bool runSurfaceBenchmark(const std::string& filename);
@@ -0,0 +1,377 @@
+//sources
+// Lawson, C. L. (1977) Software for C1 Surface Interpolation
+// Amenta, N., Choi, S., Rote, G. (2003) Incremental Constructions con BRIO
+// Devillers, O., Pion, S., Teillaud, M. (2002) Walking in a Triangulation
+// Shewchuk, J. R. (1997) Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates
+
+#include "Delaunay.h"
+#include "Morton.h"
+#include "MortonSort.h"
+#include "Parallel.h"
+#include "Profiling.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace 
+{
+    // Snapped Coordinates Span [0, 2^25), Super Vertices Stay Within 2^30 of Them So Every Predicate Is Exact
+    const int snapBits = 25;
+    const int64_t snapRange = (int64_t(1) << snapBits) - 1;
+    const int64_t superNear = -(int64_t(1) << 28);
+    const int64_t superFar = int64_t(1) << 29;
+
+    // Rounds of the Biased Randomized Insertion Order, Each About Twice the Size of the One Before
+    const unsigned brioRounds = 20;
+
+    struct GridVertex 
+    {
+        int64_t x, y;
+    };
+
+    // Signed 128-Bit Value for the In-Circle Determinant, Two's Complement Across the Halves
+    struct Int128 
+    {
+        uint64_t low;
+        uint64_t high;
+    };
+
+    Int128 negate(Int128 v) 
+    {
+        uint64_t low = ~v.low + 1;
+        return { low, ~v.high + (low == 0 ? 1 : 0) };
+    }
+
+    Int128 add(Int128 a, Int128 b) 
+    {
+        uint64_t low = a.low + b.low;
+        return { low, a.high + b.high + (low < a.low ? 1 : 0) };
+    }
+
+    // Full 64 x 64 Bit Product Built From 32-Bit Halves
+    Int128 multiply(int64_t a, int64_t b) 
+    {
+        uint64_t x = a < 0 ? 0 - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+        uint64_t y = b < 0 ? 0 - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+        uint64_t x0 = x & 0xFFFFFFFFu, x1 = x >> 32, y0 = y & 0xFFFFFFFFu, y1 = y >> 32;
+        uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+        uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+        Int128 product = { middle << 32 | (p00 & 0xFFFFFFFFu), p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32) };
+        return (a < 0) != (b < 0) ? negate(product) : product;
+    }
+
+    int sign(Int128 v) 
+    {
+        if (v.high >> 63) return -1;
+        return v.high || v.low ? 1 : 0;
+    }
+
+    // Twice the Signed Area of abc, Positive When Counter-Clockwise
+    int64_t orient(const GridVertex& a, const GridVertex& b, const GridVertex& c) 
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    // Positive When d Lies Inside the Circle Through the Counter-Clockwise Triangle abc
+    int inCircle(const GridVertex& a, const GridVertex& b, const GridVertex& c, const GridVertex& d) 
+    {
+        int64_t adx = a.x - d.x, ady = a.y - d.y;
+        int64_t bdx = b.x - d.x, bdy = b.y - d.y;
+        int64_t cdx = c.x - d.x, cdy = c.y - d.y;
+        int64_t aLift = adx * adx + ady * ady;
+        int64_t bLift = bdx * bdx + bdy * bdy;
+        int64_t cLift = cdx * cdx + cdy * cdy;
+        Int128 determinant = multiply(aLift, bdx * cdy - cdx * bdy);
+        determinant = add(determinant, multiply(bLift, cdx * ady - adx * cdy));
+        determinant = add(determinant, multiply(cLift, adx * bdy - bdx * ady));
+        return sign(determinant);
+    }
+
+    int nextCorner(int i) { return i == 2 ? 0 : i + 1; }
+    int previousCorner(int i) { return i == 0 ? 2 : i - 1; }
+
+    enum class Location 
+    {
+        Inside,
+        OnEdge,
+        OnVertex
+    };
+
+    // Triangles as Corner and Neighbor Triples, Neighbor i Lies Across the Edge Opposite Corner i
+    struct Triangulation 
+    {
+        std::vector<GridVertex> vertices;
+        std::vector<uint32_t> corners;
+        std::vector<uint32_t> adjacent;
+        std::vector<std::pair<uint32_t, int>> pending;
+
+        uint32_t addTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t na, uint32_t nb, uint32_t nc) 
+        {
+            uint32_t t = static_cast<uint32_t>(corners.size() / 3);
+            corners.insert(corners.end(), { a, b, c });
+            adjacent.insert(adjacent.end(), { na, nb, nc });
+            return t;
+        }
+
+        void setTriangle(uint32_t t, uint32_t a, uint32_t b, uint32_t c, uint32_t na, uint32_t nb, uint32_t nc) 
+        {
+            corners[3 * t] = a, corners[3 * t + 1] = b, corners[3 * t + 2] = c;
+            adjacent[3 * t] = na, adjacent[3 * t + 1] = nb, adjacent[3 * t + 2] = nc;
+        }
+
+        void replaceNeighbor(uint32_t t, uint32_t from, uint32_t to) 
+        {
+            if (t == noTriangle) return;
+            for (int i = 0; i < 3; i++) 
+            {
+                if (adjacent[3 * t + i] == from) adjacent[3 * t + i] = to;
+            }
+        }
+
+        int cornerFacing(uint32_t t, uint32_t neighbor) const 
+        {
+            for (int i = 0; i < 2; i++) 
+            {
+                if (adjacent[3 * t + i] == neighbor) return i;
+            }
+            return 2;
+        }
+    };
+
+    // Visibility Walk From t Toward p, Starting on a Different Edge Each Step
+    Location locate(const Triangulation& mesh, const GridVertex& p, uint32_t& t, int& corner) 
+    {
+        for (int rotation = 0;; rotation = nextCorner(rotation)) 
+        {
+            const uint32_t* c = &mesh.corners[3 * t];
+            int zeros = 0, zeroSum = 0;
+            bool moved = false;
+            for (int k = 0; k < 3 && !moved; k++) 
+            {
+                int i = (rotation + k) % 3;
+                int64_t side = orient(mesh.vertices[c[nextCorner(i)]], mesh.vertices[c[previousCorner(i)]], p);
+                if (side < 0) 
+                {
+                    t = mesh.adjacent[3 * t + i];
+                    moved = true;
+                }
+                else if (side == 0) 
+                {
+                    zeros++;
+                    zeroSum += i;
+                }
+            }
+            if (moved) continue;
+
+            if (zeros == 0) return Location::Inside;
+            if (zeros == 1) 
+            {
+                corner = zeroSum;
+                return Location::OnEdge;
+            }
+            corner = 3 - zeroSum;
+            return Location::OnVertex;
+        }
+    }
+
+    // Lawson Flips Until Every Edge Opposite the New Vertex Is Locally Delaunay
+    void legalize(Triangulation& mesh) 
+    {
+        while (!mesh.pending.empty()) 
+        {
+            uint32_t t = mesh.pending.back().first;
+            int i = mesh.pending.back().second;
+            mesh.pending.pop_back();
+            uint32_t u = mesh.adjacent[3 * t + i];
+            if (u == noTriangle) continue;
+
+            int j = mesh.cornerFacing(u, t);
+            uint32_t p = mesh.corners[3 * t + i], a = mesh.corners[3 * t + nextCorner(i)];
+            uint32_t b = mesh.corners[3 * t + previousCorner(i)], q = mesh.corners[3 * u + j];
+            if (inCircle(mesh.vertices[p], mesh.vertices[a], mesh.vertices[b], mesh.vertices[q]) <= 0) continue;
+
+            // Swap Diagonal ab for pq
+            uint32_t pa = mesh.adjacent[3 * t + previousCorner(i)], bp = mesh.adjacent[3 * t + nextCorner(i)];
+            uint32_t aq = mesh.adjacent[3 * u + nextCorner(j)], qb = mesh.adjacent[3 * u + previousCorner(j)];
+            mesh.setTriangle(t, p, a, q, aq, u, pa);
+            mesh.setTriangle(u, q, b, p, bp, t, qb);
+            mesh.replaceNeighbor(aq, u, t);
+            mesh.replaceNeighbor(bp, t, u);
+            mesh.pending.push_back({ t, 0 });
+            mesh.pending.push_back({ u, 2 });
+        }
+    }
+
+    // Split t Into Three Around Vertex p
+    void insertInside(Triangulation& mesh, uint32_t t, uint32_t p) 
+    {
+        uint32_t a = mesh.corners[3 * t], b = mesh.corners[3 * t + 1], c = mesh.corners[3 * t + 2];
+        uint32_t bc = mesh.adjacent[3 * t], ca = mesh.adjacent[3 * t + 1], ab = mesh.adjacent[3 * t + 2];
+        uint32_t t1 = static_cast<uint32_t>(mesh.corners.size() / 3), t2 = t1 + 1;
+        mesh.setTriangle(t, p, a, b, ab, t1, t2);
+        mesh.addTriangle(p, b, c, bc, t2, t);
+        mesh.addTriangle(p, c, a, ca, t, t1);
+        mesh.replaceNeighbor(bc, t, t1);
+        mesh.replaceNeighbor(ca, t, t2);
+        mesh.pending.push_back({ t, 0 });
+        mesh.pending.push_back({ t1, 0 });
+        mesh.pending.push_back({ t2, 0 });
+    }
+
+    // Split t and Its Neighbor Across the Edge Opposite corner Into Four Around Vertex p
+    void insertOnEdge(Triangulation& mesh, uint32_t t, int corner, uint32_t p) 
+    {
+        uint32_t u = mesh.adjacent[3 * t + corner];
+        int j = mesh.cornerFacing(u, t);
+        uint32_t c = mesh.corners[3 * t + corner], a = mesh.corners[3 * t + nextCorner(corner)];
+        uint32_t b = mesh.corners[3 * t + previousCorner(corner)], d = mesh.corners[3 * u + j];
+        uint32_t ca = mesh.adjacent[3 * t + previousCorner(corner)], bc = mesh.adjacent[3 * t + nextCorner(corner)];
+        uint32_t ad = mesh.adjacent[3 * u + nextCorner(j)], db = mesh.adjacent[3 * u + previousCorner(j)];
+        uint32_t t1 = static_cast<uint32_t>(mesh.corners.size() / 3), t3 = t1 + 1;
+        mesh.setTriangle(u, p, a, d, ad, t1, t3);
+        mesh.addTriangle(p, d, b, db, t, u);
+        mesh.setTriangle(t, p, b, c, bc, t3, t1);
+        mesh.addTriangle(p, c, a, ca, u, t);
+        mesh.replaceNeighbor(db, u, t1);
+        mesh.replaceNeighbor(ca, t, t3);
+        mesh.pending.push_back({ u, 0 });
+        mesh.pending.push_back({ t1, 0 });
+        mesh.pending.push_back({ t, 0 });
+        mesh.pending.push_back({ t3, 0 });
+    }
+
+    uint32_t mixBits(uint32_t v) 
+    {
+        v ^= v >> 16;
+        v *= 0x7FEB352Du;
+        v ^= v >> 15;
+        v *= 0x846CA68Bu;
+        v ^= v >> 16;
+        return v;
+    }
+}
+
+bool triangulatePoints(const Point* points, size_t count, TerrainMesh& mesh) 
+{
+    mesh = TerrainMesh();
+    if (count >= noTriangle / 2) 
+    {
+        std::cerr << "Too many points to triangulate: " << count << std::endl;
+        return false;
+    }
+    if (count < 3) return true;
+
+    Stopwatch timer;
+    Bounds bounds = emptyBounds();
+    for (size_t i = 0; i < count; i++) includePoint(bounds, points[i]);
+    double extent = std::max(bounds.maxX - bounds.minX, bounds.maxY - bounds.minY);
+    double scale = extent > 0.0 ? snapRange / extent : 0.0;
+
+    // Snap to the Integer Grid and Key Each Point by BRIO Round, Then Morton Code Within the Round
+    std::vector<GridVertex> snapped(count);
+    std::vector<uint64_t> keys(count);
+    std::vector<uint32_t> order(count);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            GridVertex v = { std::llround((points[i].x - bounds.minX) * scale), std::llround((points[i].y - bounds.minY) * scale) };
+            snapped[i] = v;
+            uint32_t round = brioRounds - std::min(lowestBit(mixBits(static_cast<uint32_t>(i)) | 1u << brioRounds), brioRounds);
+            keys[i] = uint64_t(round) << (2 * snapBits) | mortonEncode2(static_cast<uint32_t>(v.x), static_cast<uint32_t>(v.y));
+            order[i] = static_cast<uint32_t>(i);
+        }
+    });
+    radixSortPairs(keys, order);
+    keys = std::vector<uint64_t>();
+
+    // Vertex k Is the kth Point Inserted, the Super Triangle Follows the Points
+    uint32_t vertexCount = static_cast<uint32_t>(count);
+    Triangulation work;
+    work.vertices.resize(count + 3);
+    for (size_t k = 0; k < count; k++) work.vertices[k] = snapped[order[k]];
+    snapped = std::vector<GridVertex>();
+    work.vertices[count] = { superNear, superNear };
+    work.vertices[count + 1] = { superFar, superNear };
+    work.vertices[count + 2] = { superNear, superFar };
+    work.corners.reserve(3 * (2 * count + 1));
+    work.adjacent.reserve(3 * (2 * count + 1));
+    work.addTriangle(vertexCount, vertexCount + 1, vertexCount + 2, noTriangle, noTriangle, noTriangle);
+
+    // Consecutive Points Lie Close Together, So Each Walk Starts Where the Last Insertion Ended
+    size_t duplicates = 0;
+    uint32_t last = 0;
+    for (uint32_t k = 0; k < vertexCount; k++) 
+    {
+        int corner = 0;
+        Location location = locate(work, work.vertices[k], last, corner);
+        if (location == Location::OnVertex) 
+        {
+            duplicates++;
+            continue;
+        }
+        if (location == Location::Inside) insertInside(work, last, k);
+        else insertOnEdge(work, last, corner, k);
+        legalize(work);
+    }
+    double insertSeconds = timer.seconds();
+
+    // Drop Triangles Touching the Super Triangle; Near-Collinear Hull Edges May Go With Them
+    size_t workTriangles = work.corners.size() / 3;
+    std::vector<uint32_t> triangleRemap(workTriangles, noTriangle);
+    uint32_t kept = 0;
+    for (size_t t = 0; t < workTriangles; t++) 
+    {
+        const uint32_t* c = &work.corners[3 * t];
+        if (c[0] < vertexCount && c[1] < vertexCount && c[2] < vertexCount) triangleRemap[t] = kept++;
+    }
+
+    // Vertices Keep Their Input Order
+    std::vector<uint32_t> vertexRemap(count, noTriangle);
+    std::vector<uint8_t> used(count, 0);
+    for (size_t t = 0; t < workTriangles; t++) 
+    {
+        if (triangleRemap[t] == noTriangle) continue;
+        for (int i = 0; i < 3; i++) used[order[work.corners[3 * t + i]]] = 1;
+    }
+    uint32_t outputVertices = 0;
+    for (size_t i = 0; i < count; i++) 
+    {
+        if (used[i]) vertexRemap[i] = outputVertices++;
+    }
+
+    mesh.vertices.resize(outputVertices);
+    mesh.indices.resize(size_t(kept) * 3);
+    mesh.neighbors.resize(size_t(kept) * 3);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            if (used[i]) mesh.vertices[vertexRemap[i]] = points[i];
+        }
+    });
+    parallelFor(workTriangles, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t t = begin; t < end; t++) 
+        {
+            uint32_t target = triangleRemap[t];
+            if (target == noTriangle) continue;
+            for (int i = 0; i < 3; i++) 
+            {
+                uint32_t neighbor = work.adjacent[3 * t + i];
+                mesh.indices[3 * size_t(target) + i] = vertexRemap[order[work.corners[3 * t + i]]];
+                mesh.neighbors[3 * size_t(target) + i] = neighbor == noTriangle ? noTriangle : triangleRemap[neighbor];
+            }
+        }
+    });
+
+    double seconds = timer.seconds();
+    std::cout << "Delaunay: " << mesh.triangleCount() << " triangles over " << outputVertices << " vertices, " << duplicates
+              << " duplicate positions skipped" << std::endl;
+    std::cout << "Delaunay: " << seconds / (count / 1.0e6) << " s per million points (" << insertSeconds * 1000.0
+              << " ms inserting)" << std::endl;
+    reportThroughput("Triangulated", count, seconds);
+    return true;
+}
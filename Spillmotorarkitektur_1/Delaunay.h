@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index Value Meaning the Edge Lies on the Hull
+const uint32_t noTriangle = 0xFFFFFFFFu;
+
+// Indexed Triangle Mesh Over XY, Triangles Counter-Clockwise Seen From Above
+struct TerrainMesh 
+{
+    std::vector<Point> vertices;
+    std::vector<uint32_t> indices;
+    // neighbors[3 * t + i] Is the Triangle Across the Edge Opposite indices[3 * t + i]
+    std::vector<uint32_t> neighbors;
+
+    size_t triangleCount() const { return indices.size() / 3; }
+};
+
+// 2.5D Delaunay Triangulation of the XY Positions, Keeping z; Points Sharing an XY Position Keep Only the First
+bool triangulatePoints(const Point* points, size_t count, TerrainMesh& mesh);
@@ -1,17 +1,36 @@
 //sources
 // Assistance from ChatGPT
 
+#include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
+#include <string>
+#include <thread>
 #include <vector>
-#include <sstream>
 
-// Store XYZ Coordinates
-struct Point 
-{
-    float x, y, z;
-};
+#include "Benchmarks.h"
+#include "Delaunay.h"
+#include "Heightmap.h"
+#include "HeightmapRenderer.h"
+#include "LasReader.h"
+#include "MeshPacking.h"
+#include "MeshSimplifier.h"
+#include "MortonSort.h"
+#include "OctreeBuilder.h"
+#include "OctreeRenderer.h"
+#include "PointCache.h"
+#include "PointColumns.h"
+#include "PointRenderer.h"
+#include "Profiling.h"
+#include "ProgressiveLoader.h"
+#include "SpatialGrid.h"
+#include "TerrainLoader.h"
+#include "VoxelThinning.h"
 
 // Camera Control Variables
 float cameraAngleX = 0.0f, cameraAngleY = 0.0f;
@@ -20,89 +39,30 @@ float cameraOffsetX = 0.0f, cameraOffsetY = 0.0f;
 bool isLeftMousePressed = false, isRightMousePressed = false;
 double lastMouseX = 0.0, lastMouseY = 0.0;
 
-// Load Data From File
-std::vector<Point> loadTerrainData(const std::string& filename) 
-{
-    std::vector<Point> points;
-    std::ifstream file(filename);
-    if (!file.is_open()) 
-    {
-        std::cerr << "Failed to open file: " << filename << std::endl;
-        return points;
-    }
-
-    int numPoints;
-    file >> numPoints;
-
-    float x, y, z;
-    while (file >> x >> y >> z) 
-    {
-        points.push_back({ x, y, z });
-    }
-
-    file.close();
-    std::cout << "Loaded " << points.size() << " points." << std::endl;
-    return points;
-}
+// Class Filter, ASPRS Class 2 Is Ground
+const uint32_t groundClasses = 1u << 2;
+uint32_t visibleClasses = allClasses;
 
-// Adjust Points for Visibility
-void adjustPoints(std::vector<Point>& points) 
+// Options for the Terrain Viewer
+struct ViewerOptions 
 {
-    if (points.empty()) return;
-
-    float minX = points[0].x, maxX = points[0].x;
-    float minY = points[0].y, maxY = points[0].y;
-    float minZ = points[0].z, maxZ = points[0].z;
-
-    for (const auto& p : points) 
-    {
-        if (p.x < minX) minX = p.x;
-        if (p.x > maxX) maxX = p.x;
-        if (p.y < minY) minY = p.y;
-        if (p.y > maxY) maxY = p.y;
-        if (p.z < minZ) minZ = p.z;
-        if (p.z > maxZ) maxZ = p.z;
-    }
-
-    float centerX = (minX + maxX) / 2.0f;
-    float centerY = (minY + maxY) / 2.0f;
-    float centerZ = (minZ + maxZ) / 2.0f;
-
-    float scale = std::max({ maxX - minX, maxY - minY, maxZ - minZ }) / 2.0f;
-    if (scale == 0.0f) scale = 1.0f;
-
-    for (auto& p : points) 
-    {
-        p.x = (p.x - centerX) / scale;
-        p.y = (p.y - centerY) / scale;
-        p.z = (p.z - centerZ) / scale;
-    }
-}
+    bool quantize = false;
+    bool thin = false;
+    ThinningSettings thinning;
+};
 
-// Terrain Point Cloud
-void renderTerrain(const std::vector<Point>& points) 
-{
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glBegin(GL_POINTS);
-    for (const auto& p : points) 
-    {
-        glVertex3f(p.x, p.y, p.z);
-    }
-    glEnd();
-}
+// Startup Timing
+Stopwatch startupTimer;
+const size_t uploadPointsPerFrame = size_t(2) << 20;
 
 // Camera
-void setupCamera() 
+void setupCamera(glm::mat4& projection, glm::mat4& view) 
 {
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(-1.5, 1.5, -1.5, 1.5, -10.0, 10.0);
+    projection = glm::ortho(-1.5f, 1.5f, -1.5f, 1.5f, -10.0f, 10.0f);
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-    glTranslatef(cameraOffsetX, cameraOffsetY, -cameraDistance);
-    glRotatef(cameraAngleX, 1.0f, 0.0f, 0.0f);
-    glRotatef(cameraAngleY, 0.0f, 1.0f, 0.0f);
+    view = glm::translate(glm::mat4(1.0f), glm::vec3(cameraOffsetX, cameraOffsetY, -cameraDistance));
+    view = glm::rotate(view, glm::radians(cameraAngleX), glm::vec3(1.0f, 0.0f, 0.0f));
+    view = glm::rotate(view, glm::radians(cameraAngleY), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 // Mouse Moving for Camera
@@ -149,60 +109,539 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
     if (cameraDistance < 0.1f) cameraDistance = 0.1f;
 }
 
+// G Toggles Ground Only
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) 
+{
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) 
+    {
+        visibleClasses = visibleClasses == groundClasses ? allClasses : groundClasses;
+    }
+}
+
 // Setup OpenGL/GLFW
-void setupOpenGL(const std::vector<Point>& points) 
+GLFWwindow* setupOpenGL() 
 {
     if (!glfwInit()) 
     {
         std::cerr << "Failed to initialize GLFW" << std::endl;
-        return;
+        return nullptr;
     }
 
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+
     GLFWwindow* window = glfwCreateWindow(1920, 1080, "Terrain Render", NULL, NULL);
     if (!window) 
     {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
-        return;
+        return nullptr;
     }
 
     glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress))) 
+    {
+        std::cerr << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        return nullptr;
+    }
+
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glPointSize(0.5f);
     glEnable(GL_DEPTH_TEST);
 
-    setupCamera();
-
     // Register Callbacks
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
     glfwSetCursorPosCallback(window, cursorPositionCallback);
     glfwSetScrollCallback(window, scrollCallback);
+    glfwSetKeyCallback(window, keyCallback);
+    return window;
+}
+
+// Print How Far Quantized Positions Are From the Source Points
+void reportQuantization(const PointRenderer& renderer) 
+{
+    if (!renderer.quantized) return;
+    std::cout << "Quantized " << renderer.count << " points into " << renderer.tiles.size() << " tiles, max error "
+              << renderer.maxError << " (bound " << renderer.errorBound << ")" << std::endl;
+}
+
+// Print Extents and Height Statistics From the Columnar Copy, Overall, for Ground and for Every Point in the Ground Band
+void reportHeights(const PointColumns& columns) 
+{
+    Bounds extent = columnBounds(columns);
+    HeightStats all = heightStats(columns.z.data(), columns.size());
+    std::vector<uint32_t> ground(columns.size());
+    ground.resize(selectEqual(columns.classification.data(), columns.size(), 2, ground.data()));
+    HeightStats groundStats = heightStats(columns.z.data(), ground.data(), ground.size());
+    std::vector<uint32_t> band(columns.size());
+    band.resize(selectRange(columns.z.data(), columns.size(), groundStats.minimum, groundStats.maximum, band.data()));
+
+    std::cout << "Extent: " << extent.maxX - extent.minX << " x " << extent.maxY - extent.minY << " x "
+              << extent.maxZ - extent.minZ << std::endl;
+    std::cout << "Heights: " << all.minimum << " to " << all.maximum << ", mean " << all.mean << ", deviation "
+              << all.deviation << std::endl;
+    std::cout << "Ground heights (" << groundStats.count << " points): " << groundStats.minimum << " to "
+              << groundStats.maximum << ", mean " << groundStats.mean << ", deviation " << groundStats.deviation << std::endl;
+    std::cout << "Points of any class within the ground height band: " << band.size() << std::endl;
+}
+
+// Terrain Point Cloud
+void renderTerrain(GLFWwindow* window, PointCloud& cloud, const ViewerOptions& options) 
+{
+    if (options.thin) thinPointCloud(cloud, options.thinning);
+
+    // Upload Points Once
+    PointRenderer renderer;
+    if (!createPointRenderer(renderer, cloud.points, cloud.count, options.quantize)) return;
+    reportQuantization(renderer);
+    glm::mat4 model = normalizationMatrix(cloud.bounds);
 
     // Main Loop
+    glm::mat4 projection, view;
+    bool firstFrame = true;
     while (!glfwWindowShouldClose(window)) 
     {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        setupCamera();
-        renderTerrain(points);
+        setupCamera(projection, view);
+        drawPoints(renderer, projection * view * model);
         glfwSwapBuffers(window);
         glfwPollEvents();
+
+        if (firstFrame) 
+        {
+            std::cout << "Time to first frame: " << startupTimer.seconds() * 1000.0 << " ms" << std::endl;
+            firstFrame = false;
+        }
     }
 
-    glfwTerminate();
+    destroyPointRenderer(renderer);
+}
+
+// Terrain Point Cloud Drawn While It Is Still Being Parsed
+void renderProgressive(GLFWwindow* window, ProgressiveLoad& load, PointCloud& cloud, const ViewerOptions& options) 
+{
+    PointRenderer preview, renderer;
+    Bounds bounds = { -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+    size_t uploadedChunks = 0;
+    bool firstFrame = true, firstPoints = true, complete = false;
+    std::thread finisher;
+    std::vector<uint32_t> uploadOrder;
+    ClassIndex classes;
+    std::atomic<bool> finished{ false };
+
+    // Main Loop
+    glm::mat4 projection, view;
+    while (!glfwWindowShouldClose(window)) 
+    {
+        // Show the Coarse Random Subsample First
+        if (!preview.vao && !complete && load.previewReady.load(std::memory_order_acquire)) 
+        {
+            createPointRenderer(preview, load.preview.data(), load.preview.size());
+            if (!load.preview.empty()) bounds = load.previewBounds;
+        }
+
+        // Append Parsed Chunks, a Bounded Amount per Frame
+        if (!renderer.vao && load.layoutReady.load(std::memory_order_acquire)) 
+        {
+            reservePointRenderer(renderer, load.points.size(), options.quantize);
+        }
+        uint32_t chunk;
+        size_t uploaded = 0;
+        while (renderer.vao && uploaded < uploadPointsPerFrame && nextLoadedChunk(load, chunk)) 
+        {
+            appendPoints(renderer, load.points.data() + load.offsets[chunk], load.parsed[chunk], &load.chunkBounds[chunk]);
+            uploaded += load.parsed[chunk];
+            uploadedChunks++;
+            uploadOrder.push_back(chunk);
+        }
+
+        // Everything Is on the GPU, Finish the CPU Copy in the Background
+        if (!complete && renderer.vao && uploadedChunks == progressiveChunkCount(load)) 
+        {
+            complete = true;
+            std::cout << "Loaded " << renderer.count << " points." << std::endl;
+            std::cout << "Time to full data: " << startupTimer.seconds() * 1000.0 << " ms" << std::endl;
+            reportQuantization(renderer);
+            if (renderer.count == 0) std::cerr << "No Points Loaded" << std::endl;
+            else bounds = loadedBounds(load);
+            destroyPointRenderer(preview);
+
+            finisher = std::thread([&]() 
+            {
+                Bounds pointBounds = finishProgressiveLoad(load);
+                if (load.points.empty()) return;
+
+                // Chunks Reached the GPU Out of Order, Index Classes in Upload Order Unless Thinning Replaces Them
+                const std::vector<uint8_t>& classification = load.attributes.classification;
+                if (!classification.empty() && !options.thin) 
+                {
+                    std::vector<size_t> chunkStart(load.parsed.size() + 1, 0);
+                    for (size_t c = 0; c < load.parsed.size(); c++) chunkStart[c + 1] = chunkStart[c] + load.parsed[c];
+                    std::vector<uint8_t> uploadedClasses;
+                    uploadedClasses.reserve(classification.size());
+                    for (uint32_t c : uploadOrder) 
+                    {
+                        const uint8_t* first = classification.data() + chunkStart[c];
+                        uploadedClasses.insert(uploadedClasses.end(), first, first + load.parsed[c]);
+                    }
+                    buildClassIndex(uploadedClasses.data(), uploadedClasses.size(), classes);
+                }
+
+                // Store the CPU Copy and the Cache Along the Z-Curve
+                Stopwatch sortTimer;
+                sortPointsMorton(load.points, load.attributes, pointBounds);
+                reportThroughput("Morton sort", load.points.size(), sortTimer.seconds());
+                cloud.adopt(std::move(load.points), pointBounds);
+                cloud.attributes = std::move(load.attributes);
+                cloud.mortonSorted = true;
+                if (!load.las) writePointCache(load.filename, cloud);
+
+                if (options.thin) 
+                {
+                    thinPointCloud(cloud, options.thinning);
+                    const std::vector<uint8_t>& thinnedClasses = cloud.attributes.classification;
+                    if (!thinnedClasses.empty()) buildClassIndex(thinnedClasses.data(), cloud.count, classes);
+                }
+                finished.store(true, std::memory_order_release);
+                if (cloud.attributes.classification.empty()) return;
+
+                PointColumns columns;
+                buildColumns(cloud.points, cloud.count, cloud.attributes, columns);
+                reportHeights(columns);
+            });
+        }
+
+        // Swap In Thinned Points and Enable Class Filtering Once the Background Work Is Done
+        if (finished.exchange(false, std::memory_order_acquire)) 
+        {
+            if (options.thin) 
+            {
+                destroyPointRenderer(renderer);
+                createPointRenderer(renderer, cloud.points, cloud.count, options.quantize);
+                reportQuantization(renderer);
+            }
+            if (!classes.indices.empty()) 
+            {
+                setClassIndex(renderer, classes);
+                std::cout << "Press G to toggle ground points only." << std::endl;
+            }
+        }
+        renderer.visibleClasses = visibleClasses;
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        setupCamera(projection, view);
+        glm::mat4 mvp = projection * view * normalizationMatrix(bounds);
+        if (preview.vao) drawPoints(preview, mvp);
+        if (renderer.vao) drawPoints(renderer, mvp);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+        if (firstFrame) 
+        {
+            std::cout << "Time to first frame: " << startupTimer.seconds() * 1000.0 << " ms" << std::endl;
+            firstFrame = false;
+        }
+        if (firstPoints && (preview.count > 0 || renderer.count > 0)) 
+        {
+            std::cout << "Time to first points: " << startupTimer.seconds() * 1000.0 << " ms" << std::endl;
+            firstPoints = false;
+        }
+    }
+
+    if (finisher.joinable()) finisher.join();
+    else cancelProgressiveLoad(load);
+    destroyPointRenderer(preview);
+    destroyPointRenderer(renderer);
+}
+
+// Streamed Octree Point Cloud
+void renderOctree(GLFWwindow* window, const std::string& directory) 
+{
+    OctreeRenderer renderer;
+    if (!createOctreeRenderer(renderer, directory)) return;
+
+    // Main Loop
+    glm::mat4 projection, view;
+    Stopwatch titleTimer;
+    while (!glfwWindowShouldClose(window)) 
+    {
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        setupCamera(projection, view);
+        drawOctree(renderer, projection, view, height);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+        // Show Streaming Statistics Once a Second
+        if (titleTimer.seconds() > 1.0) 
+        {
+            std::string title = "Terrain Render - " + std::to_string(renderer.pointsDrawn) + " points in " +
+                                std::to_string(renderer.nodesDrawn) + " nodes, " + std::to_string(renderer.ramBytes >> 20) +
+                                " MB RAM, " + std::to_string(renderer.gpuBytes >> 20) + " MB GPU";
+            glfwSetWindowTitle(window, title.c_str());
+            titleTimer = Stopwatch();
+        }
+    }
+
+    destroyOctreeRenderer(renderer);
+}
+
+// Continuous Level-of-Detail Surface of a Saved Heightmap
+void renderHeightmap(GLFWwindow* window, const std::string& path) 
+{
+    Heightmap map;
+    HeightmapRenderer renderer;
+    if (!loadHeightmap(path, map) || !createHeightmapRenderer(renderer, map)) return;
+
+    // Main Loop
+    glm::mat4 projection, view;
+    Stopwatch titleTimer;
+    size_t frames = 0;
+    while (!glfwWindowShouldClose(window)) 
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        setupCamera(projection, view);
+        drawHeightmap(renderer, projection, view);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+        frames++;
+
+        // Show Frame Rate and Selection Once a Second
+        if (titleTimer.seconds() > 1.0) 
+        {
+            std::string title = "Terrain Render - " + std::to_string(static_cast<int>(frames / titleTimer.seconds())) + " fps, " +
+                                std::to_string(renderer.chunksDrawn) + " chunks, " + std::to_string(renderer.trianglesDrawn) +
+                                " triangles";
+            glfwSetWindowTitle(window, title.c_str());
+            titleTimer = Stopwatch();
+            frames = 0;
+        }
+    }
+
+    destroyHeightmapRenderer(renderer);
+}
+
+// Map the Cache or Parse the File, for the Offline Modes
+bool loadInputCloud(const std::string& input, PointCloud& cloud) 
+{
+    if (isLasFile(input) || !loadPointCache(input, cloud)) 
+    {
+        std::vector<Point> points;
+        PointAttributes attributes;
+        Bounds bounds = emptyBounds();
+        if (isLasFile(input)) loadLasData(input, points, attributes, &bounds);
+        else points = loadTerrainData(input, &bounds);
+        cloud.adopt(std::move(points), bounds);
+    }
+    if (cloud.count == 0) std::cerr << "No Points Loaded" << std::endl;
+    return cloud.count > 0;
+}
+
+// Rasterize a Point File Into a Mappable Heightmap File
+bool buildHeightmapFile(const std::string& input, const std::string& output, float cellSize, HeightAggregate aggregate,
+                        float fillRadius) 
+{
+    PointCloud cloud;
+    if (!loadInputCloud(input, cloud)) return false;
+
+    Heightmap map;
+    if (!rasterizeHeightmap(cloud.points, cloud.count, cloud.bounds, cellSize, aggregate, map)) return false;
+
+    // Holes Take Inverse-Distance Weighted Heights From Nearby Points
+    SpatialGrid grid;
+    if (fillRadius > 0.0f && buildSpatialGrid(cloud.points, cloud.count, grid)) fillHeightmapGaps(map, grid, fillRadius);
+    return saveHeightmap(output, map);
+}
+
+// Triangulate a Point File and Report Mesh Size and Build Time
+bool buildTerrainMesh(const std::string& input) 
+{
+    PointCloud cloud;
+    if (!loadInputCloud(input, cloud)) return false;
+
+    TerrainMesh mesh;
+    if (!triangulatePoints(cloud.points, cloud.count, mesh)) return false;
+    packTerrainMesh(mesh);
+    size_t meshBytes = mesh.vertices.size() * sizeof(Point) + (mesh.indices.size() + mesh.neighbors.size()) * sizeof(uint32_t);
+    std::cout << "Mesh: " << (meshBytes >> 20) << " MB, peak memory " << (peakMemoryBytes() >> 20) << " MB" << std::endl;
+    return true;
 }
 
-int main() 
+// Triangulate, Simplify and Report How Far the Result Strays From the Full Mesh
+bool buildSimplifiedMesh(const std::string& input, const SimplifySettings& settings) 
 {
+    PointCloud cloud;
+    TerrainMesh mesh, simplified;
+    if (!loadInputCloud(input, cloud) || !triangulatePoints(cloud.points, cloud.count, mesh)) return false;
+    if (!simplifyMesh(mesh, settings, simplified)) return false;
+    packTerrainMesh(simplified);
+
+    SurfaceError error = measureSurfaceError(mesh, simplified);
+    std::cout << "Vertical error max " << error.maximum << ", mean " << error.mean << ", " << error.outside
+              << " input vertices outside the simplified mesh" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) 
+{
+    // Offline Conversion: --build-octree <input> <output directory>
+    if (argc > 1 && std::string(argv[1]) == "--build-octree") 
+    {
+        if (argc < 4) 
+        {
+            std::cerr << "Usage: " << argv[0] << " --build-octree <input> <output directory>" << std::endl;
+            return -1;
+        }
+        return buildOctree(argv[2], argv[3]) ? 0 : -1;
+    }
+
+    // Offline Rasterization: --heightmap <input> <output> <cell size> [min|max|mean] [--fill <radius>]
+    if (argc > 1 && std::string(argv[1]) == "--heightmap") 
+    {
+        HeightAggregate aggregate = HeightAggregate::Mean;
+        float fillRadius = 0.0f;
+        bool valid = argc >= 5;
+        for (int i = 5; valid && i < argc; i++) 
+        {
+            std::string argument = argv[i];
+            if (argument == "--fill" && i + 1 < argc) fillRadius = std::strtof(argv[++i], nullptr);
+            else valid = parseHeightAggregate(argument, aggregate);
+        }
+        if (!valid) 
+        {
+            std::cerr << "Usage: " << argv[0] << " --heightmap <input> <output> <cell size> [min|max|mean] [--fill <radius>]"
+                      << std::endl;
+            return -1;
+        }
+        return buildHeightmapFile(argv[2], argv[3], std::strtof(argv[4], nullptr), aggregate, fillRadius) ? 0 : -1;
+    }
+
+    // Delaunay Mesh Build Timing: --triangulate <input>
+    if (argc > 2 && std::string(argv[1]) == "--triangulate") 
+    {
+        return buildTerrainMesh(argv[2]) ? 0 : -1;
+    }
+
+    // Mesh Budget Exploration: --simplify <input> [--triangles <count>] [--error <distance>]
+    if (argc > 2 && std::string(argv[1]) == "--simplify") 
+    {
+        SimplifySettings settings;
+        bool valid = true;
+        for (int i = 3; valid && i < argc; i++) 
+        {
+            std::string argument = argv[i];
+            if (argument == "--triangles" && i + 1 < argc) settings.targetTriangles = std::strtoull(argv[++i], nullptr, 10);
+            else if (argument == "--error" && i + 1 < argc) settings.maxError = std::strtof(argv[++i], nullptr);
+            else valid = false;
+        }
+        if (!valid) 
+        {
+            std::cerr << "Usage: " << argv[0] << " --simplify <input> [--triangles <count>] [--error <distance>]" << std::endl;
+            return -1;
+        }
+        return buildSimplifiedMesh(argv[2], settings) ? 0 : -1;
+    }
+
+    // Compare File Order Against Morton Order: --bench-morton <input>
+    if (argc > 2 && std::string(argv[1]) == "--bench-morton") 
+    {
+        GLFWwindow* window = setupOpenGL();
+        if (!window) return -1;
+        bool ran = runMortonBenchmark(argv[2]);
+        glfwTerminate();
+        return ran ? 0 : -1;
+    }
+
+    // Spatial Query Timing: --bench-queries <input>
+    if (argc > 2 && std::string(argv[1]) == "--bench-queries") 
+    {
+        return runQueryBenchmark(argv[2]) ? 0 : -1;
+    }
+
+    // Terrain Surface Sampling Timing: --bench-surface <input>
+    if (argc > 2 && std::string(argv[1]) == "--bench-surface") 
+    {
+        return runSurfaceBenchmark(argv[2]) ? 0 : -1;
+    }
+
+    // Level-of-Detail Viewer: --octree <octree directory>
+    if (argc > 2 && std::string(argv[1]) == "--octree") 
+    {
+        GLFWwindow* window = setupOpenGL();
+        if (!window) return -1;
+        renderOctree(window, argv[2]);
+        glfwTerminate();
+        return 0;
+    }
+
+    // Surface Viewer: --view-heightmap <heightmap file>
+    if (argc > 2 && std::string(argv[1]) == "--view-heightmap") 
+    {
+        GLFWwindow* window = setupOpenGL();
+        if (!window) return -1;
+        renderHeightmap(window, argv[2]);
+        glfwTerminate();
+        return 0;
+    }
+
+    // Viewer: [--quantize] [--thin <cell size> <first|centroid|maxz>] [input]
+    ViewerOptions options;
     std::string filename = "Elevation Data.txt";
-    std::vector<Point> points = loadTerrainData(filename);
+    for (int i = 1; i < argc; i++) 
+    {
+        std::string argument = argv[i];
+        if (argument == "--quantize") 
+        {
+            options.quantize = true;
+        }
+        else if (argument == "--thin" && i + 2 < argc && parseThinningMode(argv[i + 2], options.thinning.mode)) 
+        {
+            options.thin = true;
+            options.thinning.cellSize = std::strtof(argv[i + 1], nullptr);
+            i += 2;
+        }
+        else if (argument.compare(0, 2, "--") == 0) 
+        {
+            std::cerr << "Usage: " << argv[0] << " [--quantize] [--thin <cell size> <first|centroid|maxz>] [input]" << std::endl;
+            return -1;
+        }
+        else 
+        {
+            filename = argument;
+        }
+    }
+    PointCloud cloud;
+
+    // A Valid Cache Maps Instantly
+    if (!isLasFile(filename) && loadPointCache(filename, cloud)) 
+    {
+        GLFWwindow* window = setupOpenGL();
+        if (!window) return -1;
+        renderTerrain(window, cloud, options);
+        glfwTerminate();
+        return 0;
+    }
 
-    if (points.empty()) 
+    // Otherwise Open the Window Right Away and Parse Behind It
+    ProgressiveLoad load;
+    if (!startProgressiveLoad(load, filename)) 
     {
         std::cerr << "No Points Loaded" << std::endl;
         return -1;
     }
 
-    adjustPoints(points);
-    setupOpenGL(points);
+    GLFWwindow* window = setupOpenGL();
+    if (!window) 
+    {
+        cancelProgressiveLoad(load);
+        return -1;
+    }
+    renderProgressive(window, load, cloud, options);
+    glfwTerminate();
     return 0;
 }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm.hpp>
+
+#include "Point.h"
+
+// Clip Planes as (Normal, Distance), Inside When dot(normal, p) + distance >= 0
+struct Frustum 
+{
+    glm::vec4 planes[6];
+};
+
+// Gribb-Hartmann Plane Extraction From a Model-View-Projection Matrix
+inline Frustum extractFrustum(const glm::mat4& mvp) 
+{
+    glm::mat4 m = glm::transpose(mvp);
+    Frustum frustum;
+    frustum.planes[0] = m[3] + m[0];
+    frustum.planes[1] = m[3] - m[0];
+    frustum.planes[2] = m[3] + m[1];
+    frustum.planes[3] = m[3] - m[1];
+    frustum.planes[4] = m[3] + m[2];
+    frustum.planes[5] = m[3] - m[2];
+    return frustum;
+}
+
+// Conservative Box Test Against Every Plane
+inline bool intersectsFrustum(const Frustum& frustum, const Bounds& bounds) 
+{
+    for (const glm::vec4& plane : frustum.planes) 
+    {
+        glm::vec3 corner(plane.x >= 0.0f ? bounds.maxX : bounds.minX,
+                         plane.y >= 0.0f ? bounds.maxY : bounds.minY,
+                         plane.z >= 0.0f ? bounds.maxZ : bounds.minZ);
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) return false;
+    }
+    return true;
+}
@@ -0,0 +1,337 @@
+#include "Heightmap.h"
+#include "Parallel.h"
+#include "Profiling.h"
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <system_error>
+
+namespace 
+{
+    const char heightmapMagic[8] = { 'V', 'O', 'S', 'H', 'G', 'T', '\0', '\0' };
+    const uint32_t heightmapVersion = 1;
+    const size_t maxHeightmapCells = size_t(1) << 28;
+
+    // Cells per Tile Side, a Tile Is the Unit One Task Accumulates and Writes
+    const uint32_t tileSide = 64;
+    const size_t tileCells = size_t(tileSide) * tileSide;
+
+    // File Header, Followed by Heights at dataOffset and the Mask After Them
+    struct HeightmapHeader 
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t aggregate;
+        uint32_t columns;
+        uint32_t rows;
+        float minX, minY;
+        float cellSize;
+        uint32_t reserved;
+        uint64_t dataOffset;
+    };
+
+    const uint64_t heightmapDataOffset = (sizeof(HeightmapHeader) + 63) & ~uint64_t(63);
+
+    // One Point's Height, Bucketed Under Its Tile
+    struct TileSample 
+    {
+        uint32_t cell;                               // Cell Within the Tile
+        float z;
+    };
+
+    // Running Samples for the Tile a Worker Is Accumulating
+    struct TileSamples 
+    {
+        float minimum[tileCells];
+        float maximum[tileCells];
+        double sum[tileCells];                       // Double, So Dense Cells Keep Their Precision
+        uint32_t count[tileCells];
+
+        void clear() 
+        {
+            std::fill(minimum, minimum + tileCells, std::numeric_limits<float>::infinity());
+            std::fill(maximum, maximum + tileCells, -std::numeric_limits<float>::infinity());
+            std::fill(sum, sum + tileCells, 0.0);
+            std::fill(count, count + tileCells, 0u);
+        }
+    };
+
+    uint32_t cellIndex(float value, float minimum, float scale, uint32_t cells) 
+    {
+        float f = (value - minimum) * scale;
+        if (!(f > 0.0f)) return 0;
+        return f >= cells ? cells - 1 : static_cast<uint32_t>(f);
+    }
+}
+
+bool parseHeightAggregate(const std::string& name, HeightAggregate& aggregate) 
+{
+    if (name == "min") aggregate = HeightAggregate::Minimum;
+    else if (name == "max") aggregate = HeightAggregate::Maximum;
+    else if (name == "mean") aggregate = HeightAggregate::Mean;
+    else return false;
+    return true;
+}
+
+bool rasterizeHeightmap(const Point* points, size_t count, const Bounds& bounds, float cellSize, HeightAggregate aggregate,
+                        Heightmap& map) 
+{
+    if (!(cellSize > 0.0f)) 
+    {
+        std::cerr << "Heightmap cell size must be positive" << std::endl;
+        return false;
+    }
+
+    Stopwatch timer;
+    uint32_t columns = static_cast<uint32_t>(std::floor((bounds.maxX - bounds.minX) / cellSize)) + 1;
+    uint32_t rows = static_cast<uint32_t>(std::floor((bounds.maxY - bounds.minY) / cellSize)) + 1;
+    if (size_t(columns) * rows > maxHeightmapCells) 
+    {
+        std::cerr << "Heightmap of " << columns << " x " << rows << " cells is too large" << std::endl;
+        return false;
+    }
+    map.minX = bounds.minX;
+    map.minY = bounds.minY;
+    map.cellSize = cellSize;
+    map.columns = columns;
+    map.rows = rows;
+    map.aggregate = aggregate;
+
+    uint32_t tileColumns = (columns + tileSide - 1) / tileSide;
+    uint32_t tileRows = (rows + tileSide - 1) / tileSide;
+    size_t tileCount = size_t(tileColumns) * tileRows;
+    float scale = 1.0f / cellSize;
+
+    auto locate = [&](const Point& p, size_t& tile) -> uint32_t 
+    {
+        uint32_t column = cellIndex(p.x, bounds.minX, scale, columns);
+        uint32_t row = cellIndex(p.y, bounds.minY, scale, rows);
+        tile = size_t(row / tileSide) * tileColumns + column / tileSide;
+        return (row % tileSide) * tileSide + column % tileSide;
+    };
+
+    // Counting Sort by Tile: Each Worker Counts Its Slice, Then Scatters Into Its Own Run Inside Every Tile's Range,
+    // So Memory Grows With the Point Count Whatever Order the Input Arrives In
+    unsigned workers = workerCount();
+    std::vector<size_t> cursors(size_t(workers) * tileCount, 0);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+    {
+        size_t* counts = &cursors[size_t(worker) * tileCount];
+        size_t tile;
+        for (size_t i = begin; i < end; i++) 
+        {
+            locate(points[i], tile);
+            counts[tile]++;
+        }
+    });
+    std::vector<size_t> tileStart(tileCount + 1, 0);
+    for (size_t tile = 0, total = 0; tile < tileCount; tile++) 
+    {
+        tileStart[tile] = total;
+        for (unsigned worker = 0; worker < workers; worker++) 
+        {
+            size_t& cursor = cursors[size_t(worker) * tileCount + tile];
+            size_t slice = cursor;
+            cursor = total;
+            total += slice;
+        }
+        tileStart[tile + 1] = total;
+    }
+    std::vector<TileSample> samples(count);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+    {
+        size_t* next = &cursors[size_t(worker) * tileCount];
+        size_t tile;
+        for (size_t i = begin; i < end; i++) 
+        {
+            uint32_t cell = locate(points[i], tile);
+            samples[next[tile]++] = { cell, points[i].z };
+        }
+    });
+    std::vector<size_t>().swap(cursors);
+
+    // Accumulate Tile by Tile in One Scratch Block per Worker, Every Output Cell Has Exactly One Writer
+    std::vector<float> heights(map.cellCount(), std::numeric_limits<float>::quiet_NaN());
+    std::vector<uint8_t> mask(map.cellCount(), cellEmpty);
+    std::vector<std::unique_ptr<TileSamples>> scratch(workers);
+    parallelTasks(tileCount, [&](size_t tile, unsigned worker) 
+    {
+        if (tileStart[tile] == tileStart[tile + 1]) return;
+        if (!scratch[worker]) scratch[worker].reset(new TileSamples());
+        TileSamples& cells = *scratch[worker];
+        cells.clear();
+        for (size_t k = tileStart[tile]; k < tileStart[tile + 1]; k++) 
+        {
+            const TileSample& sample = samples[k];
+            cells.minimum[sample.cell] = std::min(cells.minimum[sample.cell], sample.z);
+            cells.maximum[sample.cell] = std::max(cells.maximum[sample.cell], sample.z);
+            cells.sum[sample.cell] += sample.z;
+            cells.count[sample.cell]++;
+        }
+
+        uint32_t firstColumn = static_cast<uint32_t>(tile % tileColumns) * tileSide;
+        uint32_t firstRow = static_cast<uint32_t>(tile / tileColumns) * tileSide;
+        uint32_t lastColumn = std::min(columns, firstColumn + tileSide);
+        uint32_t lastRow = std::min(rows, firstRow + tileSide);
+        for (uint32_t row = firstRow; row < lastRow; row++) 
+        {
+            for (uint32_t column = firstColumn; column < lastColumn; column++) 
+            {
+                size_t cell = size_t(row - firstRow) * tileSide + (column - firstColumn);
+                if (cells.count[cell] == 0) continue;
+
+                size_t index = size_t(row) * columns + column;
+                mask[index] = cellSampled;
+                switch (aggregate) 
+                {
+                case HeightAggregate::Minimum: heights[index] = cells.minimum[cell]; break;
+                case HeightAggregate::Maximum: heights[index] = cells.maximum[cell]; break;
+                case HeightAggregate::Mean: heights[index] = static_cast<float>(cells.sum[cell] / cells.count[cell]); break;
+                }
+            }
+        }
+    });
+    map.adopt(std::move(heights), std::move(mask));
+
+    size_t filled = static_cast<size_t>(std::count(map.maskStorage.begin(), map.maskStorage.end(), cellSampled));
+    std::cout << "Heightmap " << columns << " x " << rows << ", " << 100.0 * (map.cellCount() - filled) / map.cellCount()
+              << "% of cells empty" << std::endl;
+    reportThroughput("Rasterized heightmap", count, timer.seconds());
+    return true;
+}
+
+size_t fillHeightmapGaps(Heightmap& map, const SpatialGrid& grid, float maxRadius, int neighbors) 
+{
+    Stopwatch timer;
+    std::vector<PlanePoint> centers;
+    std::vector<size_t> cells;
+    for (size_t i = 0; i < map.cellCount(); i++) 
+    {
+        if (map.mask[i] != cellEmpty) continue;
+        float x = map.minX + (static_cast<float>(i % map.columns) + 0.5f) * map.cellSize;
+        float y = map.minY + (static_cast<float>(i / map.columns) + 0.5f) * map.cellSize;
+        centers.push_back({ x, y });
+        cells.push_back(i);
+    }
+
+    // Each Cell Depends Only on Its Own Neighbors, So Any Thread Count Gives the Same Grid
+    std::vector<float> filled(centers.size());
+    heightAtBatch(grid, centers.data(), centers.size(), maxRadius, filled.data(), neighbors);
+
+    // A Mapped Grid Is Read Only, Take a Private Copy First
+    if (map.heightStorage.empty()) 
+    {
+        map.adopt(std::vector<float>(map.heights, map.heights + map.cellCount()),
+                  std::vector<uint8_t>(map.mask, map.mask + map.cellCount()));
+    }
+    size_t filledCount = 0;
+    for (size_t i = 0; i < cells.size(); i++) 
+    {
+        if (std::isnan(filled[i])) continue;
+        map.heightStorage[cells[i]] = filled[i];
+        map.maskStorage[cells[i]] = cellFilled;
+        filledCount++;
+    }
+
+    std::cout << "Filled " << filledCount << " of " << cells.size() << " empty cells" << std::endl;
+    reportThroughput("Gap fill", cells.size(), timer.seconds(), "cells");
+    return filledCount;
+}
+
+bool saveHeightmap(const std::string& path, const Heightmap& map) 
+{
+    HeightmapHeader header = {};
+    std::memcpy(header.magic, heightmapMagic, sizeof(heightmapMagic));
+    header.version = heightmapVersion;
+    header.aggregate = static_cast<uint32_t>(map.aggregate);
+    header.columns = map.columns;
+    header.rows = map.rows;
+    header.minX = map.minX;
+    header.minY = map.minY;
+    header.cellSize = map.cellSize;
+    header.dataOffset = heightmapDataOffset;
+
+    // Write Beside the Final Name and Rename So Readers Never See a Partial File
+    std::string tempPath = path + ".tmp"; 
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) 
+        {
+            std::cerr << "Failed to write heightmap: " << path << std::endl;
+            return false;
+        }
+
+        char padding[heightmapDataOffset] = {};
+        std::memcpy(padding, &header, sizeof(header));
+        file.write(padding, sizeof(padding));
+        file.write(reinterpret_cast<const char*>(map.heights), static_cast<std::streamsize>(map.cellCount() * sizeof(float)));
+        file.write(reinterpret_cast<const char*>(map.mask), static_cast<std::streamsize>(map.cellCount()));
+        if (!file) 
+        {
+            std::cerr << "Failed to write heightmap: " << path << std::endl;
+            file.close();
+            std::filesystem::remove(tempPath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) 
+    {
+        std::cerr << "Failed to write heightmap: " << path << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+bool loadHeightmap(const std::string& path, Heightmap& map) 
+{
+    MappedFile file;
+    if (!file.open(path)) 
+    {
+        std::cerr << "Failed to open heightmap: " << path << std::endl;
+        return false;
+    }
+
+    HeightmapHeader header;
+    if (file.size() < sizeof(header)) 
+    {
+        std::cerr << "Heightmap is truncated: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, heightmapMagic, sizeof(heightmapMagic)) != 0 || header.version != heightmapVersion) 
+    {
+        std::cerr << "Not a heightmap file: " << path << std::endl;
+        return false;
+    }
+
+    size_t cells = size_t(header.columns) * header.rows;
+    if (header.dataOffset % alignof(float) != 0 || file.size() != header.dataOffset + cells * (sizeof(float) + 1)) 
+    {
+        std::cerr << "Heightmap is truncated: " << path << std::endl;
+        return false;
+    }
+
+    map.heightStorage = std::vector<float>();
+    map.maskStorage = std::vector<uint8_t>();
+    map.mapping = std::move(file);
+    map.minX = header.minX;
+    map.minY = header.minY;
+    map.cellSize = header.cellSize;
+    map.columns = header.columns;
+    map.rows = header.rows;
+    map.aggregate = static_cast<HeightAggregate>(header.aggregate);
+    map.heights = reinterpret_cast<const float*>(map.mapping.data() + header.dataOffset);
+    map.mask = reinterpret_cast<const uint8_t*>(map.heights + cells);
+    return true;
+}
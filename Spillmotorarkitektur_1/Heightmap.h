@@ -0,0 +1,69 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct SpatialGrid;
+
+// Mask Values: No Data, Binned From Points, or Interpolated by fillHeightmapGaps
+const uint8_t cellEmpty = 0;
+const uint8_t cellSampled = 1;
+const uint8_t cellFilled = 2;
+
+// How Samples Falling in One Cell Become Its Height
+enum class HeightAggregate : uint32_t 
+{
+    Minimum,
+    Maximum,
+    Mean
+};
+
+// Row-Major Height Grid, Cell (column, row) Covers [minX + column * cellSize, ...) and the Same for y
+// Empty Cells Hold NaN and cellEmpty in the Mask; Heights Are Owned or Viewed Straight From a Mapped File
+struct Heightmap 
+{
+    float minX = 0.0f, minY = 0.0f;
+    float cellSize = 1.0f;
+    uint32_t columns = 0, rows = 0;
+    HeightAggregate aggregate = HeightAggregate::Mean;
+
+    std::vector<float> heightStorage;
+    std::vector<uint8_t> maskStorage;
+    MappedFile mapping;
+    const float* heights = nullptr;
+    const uint8_t* mask = nullptr;
+
+    size_t cellCount() const { return size_t(columns) * rows; }
+
+    void adopt(std::vector<float>&& ownedHeights, std::vector<uint8_t>&& ownedMask) 
+    {
+        mapping.close();
+        heightStorage = std::move(ownedHeights);
+        maskStorage = std::move(ownedMask);
+        heights = heightStorage.data();
+        mask = maskStorage.data();
+    }
+};
+
+// Parse "min", "max" or "mean"
+bool parseHeightAggregate(const std::string& name, HeightAggregate& aggregate);
+
+// Bin Points Into Cells of cellSize Over bounds, in Parallel With Per-Thread Tiles Merged Tile by Tile
+bool rasterizeHeightmap(const Point* points, size_t count, const Bounds& bounds, float cellSize, HeightAggregate aggregate,
+                        Heightmap& map);
+
+// Inverse-Distance Weighted Fill of Empty Cells From the k Nearest Points Within maxRadius of Each Cell Center,
+// Cells With None in Reach Stay Empty; Returns the Number Filled
+size_t fillHeightmapGaps(Heightmap& map, const SpatialGrid& grid, float maxRadius, int neighbors = 8);
+
+// Write Header, Heights and Mask So the File Can Be Mapped Back
+bool saveHeightmap(const std::string& path, const Heightmap& map);
+
+// Map a Saved Heightmap Without Copying It
+bool loadHeightmap(const std::string& path, Heightmap& map);
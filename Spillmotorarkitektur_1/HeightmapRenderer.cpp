@@ -0,0 +1,389 @@
+//sources
+// Strugar - Continuous Distance-Dependent Level of Detail for Rendering Heightmaps (2010)
+
+#include "HeightmapRenderer.h"
+#include "Frustum.h"
+#include "MeshPacking.h"
+#include "Parallel.h"
+#include "PointRenderer.h"
+#include "Shader.h"
+
+#include <gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace 
+{
+    // Positions Arrive as [0, 1] Fractions of the Chunk; Heights Are Stored as 1 to 65535, 0 Marks an Empty Cell
+    const char* heightmapVertexShader = R"(#version 330 core
+layout(location = 0) in vec2 gridPosition;
+uniform mat4 mvp;
+uniform vec3 eye;
+uniform vec2 chunkOrigin;
+uniform float chunkSize;
+uniform vec2 morphRange;
+uniform float gridQuads;
+uniform vec2 mapSize;
+uniform vec2 mapOrigin;
+uniform float cellSize;
+uniform vec2 heightScale;
+uniform sampler2D heights;
+out float coverage;
+out vec3 normal;
+
+// Bilinear Height Over the Non-Empty Texels Around a Cell, fallback When None of the Four Has a Height
+float heightAt(vec2 cell, float fallback)
+{
+    vec2 position = clamp(cell, vec2(0.0), mapSize - 1.0);
+    ivec2 base = ivec2(floor(position));
+    ivec2 next = min(base + 1, ivec2(mapSize) - 1);
+    vec2 f = position - vec2(base);
+    vec4 encoded = vec4(texelFetch(heights, base, 0).r, texelFetch(heights, ivec2(next.x, base.y), 0).r,
+                        texelFetch(heights, ivec2(base.x, next.y), 0).r, texelFetch(heights, next, 0).r);
+    vec4 weights = vec4((1.0 - f.x) * (1.0 - f.y), f.x * (1.0 - f.y), (1.0 - f.x) * f.y, f.x * f.y);
+    weights *= step(vec4(0.5 / 65535.0), encoded);
+    float total = dot(weights, vec4(1.0));
+    if (total <= 0.0) return fallback;
+    return heightScale.x + (dot(weights, encoded) / total * 65535.0 - 1.0) * heightScale.y;
+}
+
+void main()
+{
+    vec2 cell = chunkOrigin + gridPosition * chunkSize;
+    vec3 world = vec3(mapOrigin + cell * cellSize, heightAt(cell, heightScale.x));
+    float morph = clamp((distance(eye, world) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+
+    // Odd Vertices Slide Onto Their Even Neighbours, So the Far Edge Matches the Next Coarser Level
+    float step = chunkSize / gridQuads;
+    cell -= fract(gridPosition * gridQuads * 0.5) * 2.0 * step * morph;
+    cell = clamp(cell, vec2(0.0), mapSize - 1.0);
+    float center = heightAt(cell, heightScale.x);
+    world = vec3(mapOrigin + cell * cellSize, center);
+    coverage = texelFetch(heights, ivec2(cell + 0.5), 0).r > 0.0 ? 1.0 : 0.0;
+
+    // Taps Falling in a Hole Take the Centre Height, So Hole Edges Do Not Tilt Toward the Empty Value
+    float left = heightAt(cell - vec2(step, 0.0), center), right = heightAt(cell + vec2(step, 0.0), center);
+    float down = heightAt(cell - vec2(0.0, step), center), up = heightAt(cell + vec2(0.0, step), center);
+    normal = normalize(vec3(left - right, down - up, 2.0 * step * cellSize));
+    gl_Position = mvp * vec4(world, 1.0);
+}
+)";
+
+    const char* heightmapFragmentShader = R"(#version 330 core
+in float coverage;
+in vec3 normal;
+out vec4 color;
+void main()
+{
+    if (coverage < 0.999) discard;
+    float light = 0.3 + 0.7 * max(dot(normalize(normal), normalize(vec3(0.4, 0.3, 0.85))), 0.0);
+    color = vec4(vec3(light), 1.0);
+}
+)";
+
+    const float emptyHeight = std::numeric_limits<float>::infinity();
+
+    uint32_t chunkQuads(const HeightmapRenderer& renderer, int level) 
+    {
+        return renderer.settings.leafQuads << level;
+    }
+
+    glm::vec2 chunkHeightRange(const HeightmapRenderer& renderer, int level, uint32_t x, uint32_t y) 
+    {
+        return renderer.chunkHeights[level][size_t(y) * renderer.levelColumns[level] + x];
+    }
+
+    Bounds chunkBounds(const HeightmapRenderer& renderer, int level, uint32_t x, uint32_t y) 
+    {
+        float size = chunkQuads(renderer, level) * renderer.cellSize;
+        glm::vec2 heights = chunkHeightRange(renderer, level, x, y);
+        return { renderer.minX + x * size, renderer.minY + y * size, heights.x,
+                 renderer.minX + (x + 1) * size, renderer.minY + (y + 1) * size, heights.y };
+    }
+
+    float boxDistance(const Bounds& b, const glm::vec3& p) 
+    {
+        glm::vec3 outside(std::max({ b.minX - p.x, 0.0f, p.x - b.maxX }), std::max({ b.minY - p.y, 0.0f, p.y - b.maxY }),
+                          std::max({ b.minZ - p.z, 0.0f, p.z - b.maxZ }));
+        return glm::length(outside);
+    }
+
+    // Leaf Height Ranges From the Samples Each Leaf Touches, Then Each Level From the One Below
+    void buildChunkHeights(HeightmapRenderer& renderer, const Heightmap& map) 
+    {
+        uint32_t leafQuads = renderer.settings.leafQuads;
+        uint32_t quads = std::max<uint32_t>(std::max(map.columns, map.rows) - 1, 1);
+        int levels = 1;
+        while ((leafQuads << (levels - 1)) < quads) levels++;
+
+        for (int level = 0; level < levels; level++) 
+        {
+            uint32_t size = leafQuads << level;
+            renderer.levelColumns.push_back(std::max<uint32_t>((std::max(map.columns, 2u) - 2) / size + 1, 1));
+            renderer.levelRows.push_back(std::max<uint32_t>((std::max(map.rows, 2u) - 2) / size + 1, 1));
+            renderer.chunkHeights.emplace_back(size_t(renderer.levelColumns[level]) * renderer.levelRows[level],
+                                               glm::vec2(emptyHeight, -emptyHeight));
+        }
+
+        std::vector<glm::vec2>& leaves = renderer.chunkHeights[0];
+        uint32_t leafColumns = renderer.levelColumns[0];
+        parallelFor(renderer.levelRows[0], [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t leafRow = begin; leafRow < end; leafRow++) 
+            {
+                uint32_t lastRow = std::min<uint32_t>(map.rows - 1, static_cast<uint32_t>((leafRow + 1) * leafQuads));
+                for (uint32_t row = static_cast<uint32_t>(leafRow * leafQuads); row <= lastRow; row++) 
+                {
+                    for (uint32_t column = 0; column < map.columns; column++) 
+                    {
+                        float z = map.heights[size_t(row) * map.columns + column];
+                        if (std::isnan(z)) continue;
+
+                        // Samples on a Chunk Edge Belong to Both Neighbours
+                        uint32_t first = column > 0 ? (column - 1) / leafQuads : 0;
+                        uint32_t last = std::min(column / leafQuads, leafColumns - 1);
+                        for (uint32_t leaf = first; leaf <= last; leaf++) 
+                        {
+                            glm::vec2& range = leaves[leafRow * leafColumns + leaf];
+                            range = glm::vec2(std::min(range.x, z), std::max(range.y, z));
+                        }
+                    }
+                }
+            }
+        });
+
+        for (int level = 1; level < levels; level++) 
+        {
+            for (uint32_t y = 0; y < renderer.levelRows[level - 1]; y++) 
+            {
+                for (uint32_t x = 0; x < renderer.levelColumns[level - 1]; x++) 
+                {
+                    glm::vec2 child = chunkHeightRange(renderer, level - 1, x, y);
+                    glm::vec2& range = renderer.chunkHeights[level][size_t(y / 2) * renderer.levelColumns[level] + x / 2];
+                    range = glm::vec2(std::min(range.x, child.x), std::max(range.y, child.y));
+                }
+            }
+        }
+
+        float leafSize = leafQuads * map.cellSize;
+        for (int level = 0; level < levels; level++) renderer.ranges.push_back(renderer.settings.leafRange * leafSize * float(1u << level));
+    }
+
+    // Shared Chunk Mesh, Indices Grouped by Quadrant So Any Quarter Is One Contiguous Draw
+    void createChunkMesh(HeightmapRenderer& renderer) 
+    {
+        uint32_t quads = renderer.settings.leafQuads;
+        std::vector<glm::vec2> vertices;
+        for (uint32_t y = 0; y <= quads; y++) 
+        {
+            for (uint32_t x = 0; x <= quads; x++) vertices.push_back(glm::vec2(x, y) / float(quads));
+        }
+
+        // Each Quarter Is Cache-Ordered on Its Own, Then Vertices Follow the Combined Index Order
+        std::vector<uint32_t> indices, quarterList;
+        uint32_t half = quads / 2;
+        for (int quarter = 0; quarter < 4; quarter++) 
+        {
+            uint32_t x0 = (quarter & 1) * half, y0 = (quarter >> 1) * half;
+            quarterList.clear();
+            for (uint32_t y = y0; y < y0 + half; y++) 
+            {
+                for (uint32_t x = x0; x < x0 + half; x++) 
+                {
+                    uint32_t corner = y * (quads + 1) + x;
+                    quarterList.insert(quarterList.end(), { corner, corner + 1, corner + quads + 2, corner, corner + quads + 2, corner + quads + 1 });
+                }
+            }
+            reorderTriangles(quarterList, vertexCacheOrder(quarterList.data(), quarterList.size(), vertices.size()));
+            indices.insert(indices.end(), quarterList.begin(), quarterList.end());
+        }
+        std::vector<uint32_t> remap;
+        size_t used = vertexFetchRemap(indices, vertices.size(), remap);
+        remapVertices(vertices, remap, used);
+        renderer.quarterIndices = static_cast<GLsizei>(indices.size() / 4);
+
+        glGenVertexArrays(1, &renderer.vao);
+        glGenBuffers(1, &renderer.vbo);
+        glGenBuffers(1, &renderer.ebo);
+        glBindVertexArray(renderer.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(glm::vec2)), vertices.data(), GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data(), GL_STATIC_DRAW);
+        glBindVertexArray(0);
+    }
+
+    // Heights Scaled Into 1 to 65535 Over the Map's Range, Empty Cells as 0
+    bool uploadHeights(HeightmapRenderer& renderer, const Heightmap& map) 
+    {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (map.columns > static_cast<uint32_t>(maxSize) || map.rows > static_cast<uint32_t>(maxSize)) 
+        {
+            std::cerr << "Heightmap of " << map.columns << " x " << map.rows << " exceeds the texture limit of " << maxSize << std::endl;
+            return false;
+        }
+
+        float scale = renderer.maxZ > renderer.minZ ? 65534.0f / (renderer.maxZ - renderer.minZ) : 0.0f;
+        std::vector<uint16_t> encoded(map.cellCount());
+        parallelFor(map.cellCount(), [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t i = begin; i < end; i++) 
+            {
+                float z = map.heights[i];
+                encoded[i] = std::isnan(z) ? 0 : static_cast<uint16_t>(1.0f + std::round((z - renderer.minZ) * scale));
+            }
+        });
+
+        glGenTextures(1, &renderer.texture);
+        glBindTexture(GL_TEXTURE_2D, renderer.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R16, static_cast<GLsizei>(map.columns), static_cast<GLsizei>(map.rows), 0, GL_RED,
+                     GL_UNSIGNED_SHORT, encoded.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return true;
+    }
+
+    // Returns false When the Chunk Lies Beyond Its Level's Range, So the Parent Draws That Quarter Itself
+    bool selectChunk(HeightmapRenderer& renderer, const Frustum& frustum, const glm::vec3& eye, int level, uint32_t x, uint32_t y) 
+    {
+        glm::vec2 heights = chunkHeightRange(renderer, level, x, y);
+        if (heights.x > heights.y) return true;
+
+        Bounds bounds = chunkBounds(renderer, level, x, y);
+        float distance = boxDistance(bounds, eye);
+        bool top = level + 1 == static_cast<int>(renderer.ranges.size());
+        if (!top && distance > renderer.ranges[level]) return false;
+        if (!intersectsFrustum(frustum, bounds)) return true;
+
+        if (level == 0 || distance > renderer.ranges[level - 1]) 
+        {
+            renderer.selection.push_back({ level, x, y, -1 });
+            return true;
+        }
+        for (int quarter = 0; quarter < 4; quarter++) 
+        {
+            uint32_t childX = 2 * x + (quarter & 1), childY = 2 * y + (quarter >> 1);
+            if (childX >= renderer.levelColumns[level - 1] || childY >= renderer.levelRows[level - 1]) continue;
+            if (selectChunk(renderer, frustum, eye, level - 1, childX, childY)) continue;
+            if (intersectsFrustum(frustum, chunkBounds(renderer, level - 1, childX, childY))) renderer.selection.push_back({ level, x, y, quarter });
+        }
+        return true;
+    }
+}
+
+bool createHeightmapRenderer(HeightmapRenderer& renderer, const Heightmap& map, const HeightmapViewSettings& settings) 
+{
+    if (map.cellCount() == 0) return false;
+    renderer.settings = settings;
+    renderer.settings.leafQuads = std::max<uint32_t>(2, settings.leafQuads & ~1u);
+    renderer.columns = map.columns;
+    renderer.rows = map.rows;
+    renderer.minX = map.minX;
+    renderer.minY = map.minY;
+    renderer.cellSize = map.cellSize;
+
+    renderer.minZ = emptyHeight;
+    renderer.maxZ = -emptyHeight;
+    for (size_t i = 0; i < map.cellCount(); i++) 
+    {
+        if (std::isnan(map.heights[i])) continue;
+        renderer.minZ = std::min(renderer.minZ, map.heights[i]);
+        renderer.maxZ = std::max(renderer.maxZ, map.heights[i]);
+    }
+    if (renderer.minZ > renderer.maxZ) 
+    {
+        std::cerr << "Heightmap has no samples" << std::endl;
+        return false;
+    }
+
+    renderer.program = createShaderProgram(heightmapVertexShader, heightmapFragmentShader);
+    if (!renderer.program) return false;
+    if (!uploadHeights(renderer, map)) return false;
+    buildChunkHeights(renderer, map);
+    createChunkMesh(renderer);
+    renderer.model = normalizationMatrix(heightmapBounds(renderer));
+
+    // Values Fixed for the Life of the Renderer
+    glUseProgram(renderer.program);
+    glUniform1f(glGetUniformLocation(renderer.program, "gridQuads"), static_cast<float>(renderer.settings.leafQuads));
+    glUniform2f(glGetUniformLocation(renderer.program, "mapSize"), static_cast<float>(map.columns), static_cast<float>(map.rows));
+    glUniform2f(glGetUniformLocation(renderer.program, "mapOrigin"), map.minX, map.minY);
+    glUniform1f(glGetUniformLocation(renderer.program, "cellSize"), map.cellSize);
+    glUniform2f(glGetUniformLocation(renderer.program, "heightScale"), renderer.minZ, (renderer.maxZ - renderer.minZ) / 65534.0f);
+    glUniform1i(glGetUniformLocation(renderer.program, "heights"), 0);
+    renderer.mvpLocation = glGetUniformLocation(renderer.program, "mvp");
+    renderer.eyeLocation = glGetUniformLocation(renderer.program, "eye");
+    renderer.chunkOriginLocation = glGetUniformLocation(renderer.program, "chunkOrigin");
+    renderer.chunkSizeLocation = glGetUniformLocation(renderer.program, "chunkSize");
+    renderer.morphRangeLocation = glGetUniformLocation(renderer.program, "morphRange");
+
+    std::cout << "Heightmap renderer: " << renderer.ranges.size() << " levels, " << renderer.chunkHeights[0].size() << " leaf chunks"
+              << std::endl;
+    return true;
+}
+
+Bounds heightmapBounds(const HeightmapRenderer& renderer) 
+{
+    return { renderer.minX, renderer.minY, renderer.minZ, renderer.minX + (renderer.columns - 1) * renderer.cellSize,
+             renderer.minY + (renderer.rows - 1) * renderer.cellSize, renderer.maxZ };
+}
+
+void drawHeightmap(HeightmapRenderer& renderer, const glm::mat4& projection, const glm::mat4& view) 
+{
+    glm::mat4 mvp = projection * view * renderer.model;
+    glm::vec3 eye = glm::vec3(glm::inverse(view * renderer.model) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    renderer.selection.clear();
+    Frustum frustum = extractFrustum(mvp);
+    int top = static_cast<int>(renderer.ranges.size()) - 1;
+    for (uint32_t y = 0; y < renderer.levelRows[top]; y++) 
+    {
+        for (uint32_t x = 0; x < renderer.levelColumns[top]; x++) selectChunk(renderer, frustum, eye, top, x, y);
+    }
+
+    glUseProgram(renderer.program);
+    glUniformMatrix4fv(renderer.mvpLocation, 1, GL_FALSE, glm::value_ptr(mvp));
+    glUniform3fv(renderer.eyeLocation, 1, glm::value_ptr(eye));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, renderer.texture);
+    glBindVertexArray(renderer.vao);
+
+    renderer.trianglesDrawn = 0;
+    for (const HeightmapChunk& chunk : renderer.selection) 
+    {
+        float size = static_cast<float>(chunkQuads(renderer, chunk.level));
+        float rangeEnd = renderer.ranges[chunk.level];
+        float rangeStart = chunk.level > 0 ? renderer.ranges[chunk.level - 1] : 0.0f;
+        glUniform2f(renderer.chunkOriginLocation, chunk.x * size, chunk.y * size);
+        glUniform1f(renderer.chunkSizeLocation, size);
+        glUniform2f(renderer.morphRangeLocation, rangeStart + (rangeEnd - rangeStart) * renderer.settings.morphStart, rangeEnd);
+
+        GLsizei first = chunk.quarter < 0 ? 0 : chunk.quarter * renderer.quarterIndices;
+        GLsizei count = chunk.quarter < 0 ? 4 * renderer.quarterIndices : renderer.quarterIndices;
+        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, reinterpret_cast<const void*>(first * sizeof(uint32_t)));
+        renderer.trianglesDrawn += count / 3;
+    }
+    renderer.chunksDrawn = renderer.selection.size();
+    glBindVertexArray(0);
+}
+
+void destroyHeightmapRenderer(HeightmapRenderer& renderer) 
+{
+    glDeleteTextures(1, &renderer.texture);
+    glDeleteBuffers(1, &renderer.ebo);
+    glDeleteBuffers(1, &renderer.vbo);
+    glDeleteVertexArrays(1, &renderer.vao);
+    glDeleteProgram(renderer.program);
+    renderer = HeightmapRenderer();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm.hpp>
+
+#include "Heightmap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Level-of-Detail Limits for the Heightmap Viewer
+struct HeightmapViewSettings 
+{
+    uint32_t leafQuads = 32;                     // Grid Quads Along a Leaf Chunk Edge, Even
+    float leafRange = 3.0f;                      // Leaf LOD Reach in Leaf Chunk Widths, Doubling per Level
+    float morphStart = 0.7f;                     // Fraction of Each LOD Band Drawn Before Morphing Begins
+};
+
+// Chunk Drawn This Frame, quarter Is -1 for the Whole Chunk or 0-3 for One Quadrant
+struct HeightmapChunk 
+{
+    int level;
+    uint32_t x, y;
+    int quarter;
+};
+
+// CDLOD Quadtree Over a Heightmap: One Shared Grid Mesh, Heights Read From an R16 Texture
+struct HeightmapRenderer 
+{
+    HeightmapViewSettings settings;
+    uint32_t columns = 0, rows = 0;
+    float minX = 0.0f, minY = 0.0f, cellSize = 1.0f;
+    float minZ = 0.0f, maxZ = 0.0f;
+    glm::mat4 model = glm::mat4(1.0f);
+
+    // Per Level, Chunk Counts and Height Ranges Row by Row; Level 0 Holds the Leaves
+    std::vector<uint32_t> levelColumns, levelRows;
+    std::vector<std::vector<glm::vec2>> chunkHeights;
+    std::vector<float> ranges;
+    std::vector<HeightmapChunk> selection;
+
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint texture = 0;
+    GLsizei quarterIndices = 0;
+    GLint mvpLocation = -1, eyeLocation = -1, chunkOriginLocation = -1, chunkSizeLocation = -1, morphRangeLocation = -1;
+
+    // Last Frame's Statistics
+    size_t chunksDrawn = 0;
+    size_t trianglesDrawn = 0;
+};
+
+// Upload Heights and Build the Chunk Hierarchy; Empty Cells Are Left Out of the Surface
+bool createHeightmapRenderer(HeightmapRenderer& renderer, const Heightmap& map, const HeightmapViewSettings& settings = {});
+
+// World Box Covered by the Heightmap
+Bounds heightmapBounds(const HeightmapRenderer& renderer);
+
+// Select Chunks by Distance From the Camera, Cull Them and Draw
+void drawHeightmap(HeightmapRenderer& renderer, const glm::mat4& projection, const glm::mat4& view);
+
+// Release GL Objects
+void destroyHeightmapRenderer(HeightmapRenderer& renderer);
@@ -0,0 +1,164 @@
+//sources
+// ASPRS LAS Specification 1.2, 1.3 and 1.4
+
+#include "LasReader.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+#include "Profiling.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+
+namespace 
+{
+    // Smallest Record Size for Point Data Formats 0-3
+    const uint16_t minimumRecordLength[4] = { 20, 28, 26, 34 };
+
+    template <typename T>
+    T readValue(const char* data, size_t offset) 
+    {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    }
+}
+
+bool isLasFile(const std::string& filename) 
+{
+    if (filename.size() < 4) return false;
+    std::string extension = filename.substr(filename.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".las";
+}
+
+bool readLasHeader(const char* data, size_t size, LasHeader& header) 
+{
+    if (size < 227 || std::memcmp(data, "LASF", 4) != 0) 
+    {
+        std::cerr << "Not a LAS file" << std::endl;
+        return false;
+    }
+
+    header.versionMajor = readValue<uint8_t>(data, 24);
+    header.versionMinor = readValue<uint8_t>(data, 25);
+    uint16_t headerSize = readValue<uint16_t>(data, 94);
+    header.pointOffset = readValue<uint32_t>(data, 96);
+    header.pointFormat = readValue<uint8_t>(data, 104);
+    header.recordLength = readValue<uint16_t>(data, 105);
+    header.pointCount = readValue<uint32_t>(data, 107);
+
+    for (int axis = 0; axis < 3; axis++) 
+    {
+        header.scale[axis] = readValue<double>(data, 131 + axis * 8);
+        header.offset[axis] = readValue<double>(data, 155 + axis * 8);
+        header.max[axis] = readValue<double>(data, 179 + axis * 16);
+        header.min[axis] = readValue<double>(data, 187 + axis * 16);
+    }
+
+    // LAS 1.4 Moves the Point Count to a 64-Bit Field
+    if (header.versionMinor >= 4 && headerSize >= 375 && size >= 375) 
+    {
+        header.pointCount = readValue<uint64_t>(data, 247);
+    }
+
+    if (header.versionMajor != 1 || header.versionMinor > 4) 
+    {
+        std::cerr << "Unsupported LAS version " << int(header.versionMajor) << "." << int(header.versionMinor) << std::endl;
+        return false;
+    }
+
+    // Compressed (LAZ) Files Set the High Bits of the Format Byte
+    if (header.pointFormat & 0xC0) 
+    {
+        std::cerr << "Compressed LAZ point data is not supported" << std::endl;
+        return false;
+    }
+
+    if (header.pointFormat > 3) 
+    {
+        std::cerr << "Unsupported LAS point data format " << int(header.pointFormat) << std::endl;
+        return false;
+    }
+
+    if (header.recordLength < minimumRecordLength[header.pointFormat]) 
+    {
+        std::cerr << "LAS point record length " << header.recordLength << " is too short for format "
+                  << int(header.pointFormat) << std::endl;
+        return false;
+    }
+
+    if (header.pointOffset > size || (size - header.pointOffset) / header.recordLength < header.pointCount) 
+    {
+        std::cerr << "LAS file is truncated" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void decodeLasPoints(const char* records, const LasHeader& header, size_t count, Point* out,
+                     uint16_t* intensity, uint8_t* classification, uint8_t* returnNumber, Bounds* bounds) 
+{
+    const char* record = records;
+    for (size_t first = 0; first < count; first += boundsBlockPoints) 
+    {
+        size_t last = std::min(count, first + boundsBlockPoints);
+        for (size_t i = first; i < last; i++, record += header.recordLength) 
+        {
+            out[i].x = static_cast<float>(readValue<int32_t>(record, 0) * header.scale[0] + header.offset[0]);
+            out[i].y = static_cast<float>(readValue<int32_t>(record, 4) * header.scale[1] + header.offset[1]);
+            out[i].z = static_cast<float>(readValue<int32_t>(record, 8) * header.scale[2] + header.offset[2]);
+
+            if (intensity) intensity[i] = readValue<uint16_t>(record, 12);
+            if (returnNumber) returnNumber[i] = readValue<uint8_t>(record, 14) & 0x07;
+            if (classification) classification[i] = readValue<uint8_t>(record, 15) & 0x1F;
+        }
+
+        // Fold the Block Into the Bounds While It Is Still in Cache
+        if (bounds) includeBounds(*bounds, computeBounds(out + first, last - first));
+    }
+}
+
+bool loadLasData(const std::string& filename, std::vector<Point>& points, PointAttributes& attributes, Bounds* bounds) 
+{
+    MappedFile file;
+    if (!file.open(filename)) 
+    {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    LasHeader header;
+    if (!readLasHeader(file.data(), file.size(), header)) return false;
+
+    Stopwatch timer;
+    size_t count = static_cast<size_t>(header.pointCount);
+    points.resize(count);
+    attributes.intensity.resize(count);
+    attributes.classification.resize(count);
+    attributes.returnNumber.resize(count);
+
+    // Decode Fixed-Size Records in Parallel Blocks
+    const size_t blockSize = 1 << 16;
+    size_t blockCount = (count + blockSize - 1) / blockSize;
+    std::vector<Bounds> blockBounds(blockCount, emptyBounds());
+    parallelTasks(blockCount, [&](size_t block, unsigned) 
+    {
+        size_t first = block * blockSize;
+        const char* records = file.data() + header.pointOffset + first * header.recordLength;
+        decodeLasPoints(records, header, std::min(blockSize, count - first), points.data() + first,
+                        attributes.intensity.data() + first, attributes.classification.data() + first,
+                        attributes.returnNumber.data() + first, bounds ? &blockBounds[block] : nullptr);
+    });
+    if (bounds) 
+    {
+        for (const Bounds& b : blockBounds) includeBounds(*bounds, b);
+    }
+
+    std::cout << "Loaded " << points.size() << " points from LAS " << int(header.versionMajor) << "."
+              << int(header.versionMinor) << " format " << int(header.pointFormat) << "." << std::endl;
+    reportThroughput("Decoded LAS", points.size(), timer.seconds());
+    return true;
+}
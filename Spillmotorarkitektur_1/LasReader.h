@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-Point Attributes Kept Alongside Positions
+struct PointAttributes 
+{
+    std::vector<uint16_t> intensity;
+    std::vector<uint8_t> classification;
+    std::vector<uint8_t> returnNumber;
+};
+
+// Fields of the LAS Public Header Block Needed to Decode Points
+struct LasHeader 
+{
+    uint8_t versionMajor = 0, versionMinor = 0;
+    uint8_t pointFormat = 0;
+    uint16_t recordLength = 0;
+    uint32_t pointOffset = 0;
+    uint64_t pointCount = 0;
+    double scale[3] = {};
+    double offset[3] = {};
+    double min[3] = {};
+    double max[3] = {};
+};
+
+// True for Files With a .las Extension
+bool isLasFile(const std::string& filename);
+
+// Parse and Validate the Public Header of an Uncompressed LAS 1.x File
+bool readLasHeader(const char* data, size_t size, LasHeader& header);
+
+// Decode count Records Starting at records, Attribute Outputs May Be Null; Grows bounds if Given
+void decodeLasPoints(const char* records, const LasHeader& header, size_t count, Point* out,
+                     uint16_t* intensity, uint8_t* classification, uint8_t* returnNumber, Bounds* bounds = nullptr);
+
+// Load Points and Attributes From a LAS File, Bounds Are Gathered While Decoding
+bool loadLasData(const std::string& filename, std::vector<Point>& points, PointAttributes& attributes,
+                 Bounds* bounds = nullptr);
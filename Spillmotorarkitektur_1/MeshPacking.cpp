@@ -0,0 +1,236 @@
+//sources
+// Forsyth, T. (2006) Linear-Speed Vertex Cache Optimisation
+
+#include "MeshPacking.h"
+#include "MortonSort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace 
+{
+    // Simulated LRU Cache and Score Tables for Forsyth's Heuristic
+    const int scoreCacheSize = 32;
+    const int maxValence = 64;
+
+    struct ScoreTables 
+    {
+        float cache[scoreCacheSize];
+        float valence[maxValence];
+
+        ScoreTables() 
+        {
+            for (int i = 0; i < scoreCacheSize; i++) 
+            {
+                cache[i] = i < 3 ? 0.75f : std::pow(1.0f - float(i - 3) / (scoreCacheSize - 3), 1.5f);
+            }
+            valence[0] = 0.0f;
+            for (int i = 1; i < maxValence; i++) valence[i] = 2.0f / std::sqrt(float(i));
+        }
+    };
+
+    float vertexScore(const ScoreTables& tables, int cachePosition, uint32_t remaining) 
+    {
+        if (remaining == 0) return -1.0f;
+        float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+        return score + tables.valence[std::min<uint32_t>(remaining, maxValence - 1)];
+    }
+}
+
+std::vector<uint32_t> vertexCacheOrder(const uint32_t* indices, size_t indexCount, size_t vertexCount) 
+{
+    static const ScoreTables tables;
+    size_t triangleCount = indexCount / 3;
+
+    // Triangles Around Each Vertex, the Still-Unplaced Ones Kept at the Front of Each Run
+    std::vector<uint32_t> start(vertexCount + 1, 0), remaining(vertexCount, 0);
+    for (size_t i = 0; i < indexCount; i++) start[indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; v++) start[v + 1] += start[v];
+    std::vector<uint32_t> around(indexCount);
+    for (size_t i = 0; i < indexCount; i++) around[start[indices[i]] + remaining[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount), triangleScore(triangleCount, 0.0f);
+    std::vector<uint8_t> placed(triangleCount, 0);
+    for (size_t v = 0; v < vertexCount; v++) score[v] = vertexScore(tables, -1, remaining[v]);
+    for (size_t i = 0; i < indexCount; i++) triangleScore[i / 3] += score[indices[i]];
+
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    std::vector<uint32_t> cache, nextCache;
+    int64_t best = triangleCount > 0 ? std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin() : -1;
+    size_t scan = 0;
+    while (order.size() < triangleCount) 
+    {
+        // Nothing Cached Is Left to Draw, Take the Next Unplaced Triangle
+        if (best < 0) 
+        {
+            while (placed[scan]) scan++;
+            best = static_cast<int64_t>(scan);
+        }
+        uint32_t t = static_cast<uint32_t>(best);
+        placed[t] = 1;
+        order.push_back(t);
+
+        const uint32_t* corners = indices + 3 * size_t(t);
+        for (int i = 0; i < 3; i++) 
+        {
+            uint32_t v = corners[i];
+            uint32_t* begin = &around[start[v]];
+            uint32_t* end = begin + remaining[v];
+            std::iter_swap(std::find(begin, end, t), end - 1);
+            remaining[v]--;
+        }
+
+        // The Drawn Triangle's Vertices Move to the Front, Older Entries Shift Back and the Tail Falls Out
+        nextCache.assign(corners, corners + 3);
+        for (uint32_t v : cache) 
+        {
+            if (v != corners[0] && v != corners[1] && v != corners[2]) nextCache.push_back(v);
+        }
+        for (size_t i = scoreCacheSize; i < nextCache.size(); i++) cachePosition[nextCache[i]] = -1;
+        for (size_t i = 0; i < nextCache.size(); i++) 
+        {
+            uint32_t v = nextCache[i];
+            if (i < size_t(scoreCacheSize)) cachePosition[v] = static_cast<int>(i);
+            float updated = vertexScore(tables, cachePosition[v], remaining[v]);
+            float delta = updated - score[v];
+            score[v] = updated;
+            for (uint32_t k = start[v]; k < start[v] + remaining[v]; k++) triangleScore[around[k]] += delta;
+        }
+        if (nextCache.size() > size_t(scoreCacheSize)) nextCache.resize(scoreCacheSize);
+        cache.swap(nextCache);
+
+        best = -1;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) 
+        {
+            for (uint32_t k = start[v]; k < start[v] + remaining[v]; k++) 
+            {
+                if (triangleScore[around[k]] > bestScore) 
+                {
+                    bestScore = triangleScore[around[k]];
+                    best = around[k];
+                }
+            }
+        }
+    }
+    return order;
+}
+
+void reorderTriangles(std::vector<uint32_t>& indices, const std::vector<uint32_t>& order) 
+{
+    std::vector<uint32_t> reordered(order.size() * 3);
+    for (size_t k = 0; k < order.size(); k++) 
+    {
+        std::copy_n(indices.begin() + 3 * size_t(order[k]), 3, reordered.begin() + 3 * k);
+    }
+    indices.swap(reordered);
+}
+
+size_t vertexFetchRemap(std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& remap) 
+{
+    remap.assign(vertexCount, stripRestart);
+    uint32_t next = 0;
+    for (uint32_t& v : indices) 
+    {
+        if (remap[v] == stripRestart) remap[v] = next++;
+        v = remap[v];
+    }
+    return next;
+}
+
+float cacheMissRatio(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize) 
+{
+    if (indexCount < 3) return 0.0f;
+
+    // Entry Time per Vertex; a Vertex Is Cached While Fewer Than cacheSize Misses Followed It
+    std::vector<uint64_t> loadedAt(vertexCount, 0);
+    uint64_t misses = 0;
+    for (size_t i = 0; i < indexCount; i++) 
+    {
+        uint64_t& loaded = loadedAt[indices[i]];
+        if (loaded == 0 || misses - loaded >= cacheSize) 
+        {
+            misses++;
+            loaded = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+}
+
+std::vector<uint32_t> buildTriangleStrips(const std::vector<uint32_t>& indices) 
+{
+    size_t triangleCount = indices.size() / 3;
+
+    // Directed Edges Sorted So the Triangle Owning a->b Can Be Found by Binary Search
+    std::vector<uint64_t> edges(indices.size());
+    std::vector<uint32_t> owners(indices.size());
+    for (size_t e = 0; e < indices.size(); e++) 
+    {
+        size_t t = e / 3;
+        uint64_t a = indices[e], b = indices[3 * t + (e + 1) % 3];
+        edges[e] = a << 32 | b;
+        owners[e] = static_cast<uint32_t>(t);
+    }
+    radixSortPairs(edges, owners);
+    std::vector<uint8_t> used(triangleCount, 0);
+    auto owner = [&](uint32_t a, uint32_t b) -> int64_t 
+    {
+        uint64_t key = uint64_t(a) << 32 | b;
+        auto found = std::lower_bound(edges.begin(), edges.end(), key);
+        if (found == edges.end() || *found != key) return -1;
+        uint32_t t = owners[found - edges.begin()];
+        return used[t] ? -1 : int64_t(t);
+    };
+
+    std::vector<uint32_t> strips;
+    for (size_t first = 0; first < triangleCount; first++) 
+    {
+        if (used[first]) continue;
+        if (!strips.empty()) strips.push_back(stripRestart);
+        used[first] = 1;
+        strips.insert(strips.end(), indices.begin() + 3 * first, indices.begin() + 3 * first + 3);
+
+        // Odd Positions in a Strip Flip Winding, So the Shared Edge Is Walked Backwards There
+        for (size_t position = 1;; position++) 
+        {
+            uint32_t x = strips[strips.size() - 2], y = strips.back();
+            int64_t next = position % 2 == 0 ? owner(x, y) : owner(y, x);
+            if (next < 0) break;
+            used[next] = 1;
+            const uint32_t* c = &indices[3 * size_t(next)];
+            strips.push_back(c[0] != x && c[0] != y ? c[0] : c[1] != x && c[1] != y ? c[1] : c[2]);
+        }
+    }
+    return strips;
+}
+
+void packTerrainMesh(TerrainMesh& mesh) 
+{
+    size_t vertexCount = mesh.vertices.size(), triangleCount = mesh.triangleCount();
+    float before = cacheMissRatio(mesh.indices.data(), mesh.indices.size(), vertexCount);
+
+    std::vector<uint32_t> order = vertexCacheOrder(mesh.indices.data(), mesh.indices.size(), vertexCount);
+    std::vector<uint32_t> position(triangleCount);
+    for (size_t k = 0; k < triangleCount; k++) position[order[k]] = static_cast<uint32_t>(k);
+    std::vector<uint32_t> neighbors(mesh.neighbors.size());
+    for (size_t k = 0; k < triangleCount; k++) 
+    {
+        for (int i = 0; i < 3; i++) 
+        {
+            uint32_t neighbor = mesh.neighbors[3 * size_t(order[k]) + i];
+            neighbors[3 * k + i] = neighbor == noTriangle ? noTriangle : position[neighbor];
+        }
+    }
+    reorderTriangles(mesh.indices, order);
+    mesh.neighbors.swap(neighbors);
+
+    std::vector<uint32_t> remap;
+    size_t used = vertexFetchRemap(mesh.indices, vertexCount, remap);
+    remapVertices(mesh.vertices, remap, used);
+
+    float after = cacheMissRatio(mesh.indices.data(), mesh.indices.size(), used);
+    std::cout << "Vertex cache: ACMR " << before << " -> " << after << std::endl;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Delaunay.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index Ending One Strip and Starting the Next Under GL_PRIMITIVE_RESTART
+const uint32_t stripRestart = 0xFFFFFFFFu;
+
+// Triangle Order for Post-Transform Cache Reuse, order[k] Is the Triangle Drawn kth
+std::vector<uint32_t> vertexCacheOrder(const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+// Rewrite Indices Into Triangle Order
+void reorderTriangles(std::vector<uint32_t>& indices, const std::vector<uint32_t>& order);
+
+// Number Vertices by First Use and Rewrite Indices; remap[old] Is the New Index, Unused Vertices Get stripRestart
+size_t vertexFetchRemap(std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& remap);
+
+// Move Vertices to Their New Slots, Dropping Unused Ones
+template <typename Vertex>
+void remapVertices(std::vector<Vertex>& vertices, const std::vector<uint32_t>& remap, size_t usedCount) 
+{
+    std::vector<Vertex> packed(usedCount);
+    for (size_t v = 0; v < vertices.size(); v++) 
+    {
+        if (remap[v] != stripRestart) packed[remap[v]] = vertices[v];
+    }
+    vertices.swap(packed);
+}
+
+// Average Cache Miss Ratio (Transformed Vertices per Triangle) of a FIFO Cache Over a Triangle List
+float cacheMissRatio(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize = 16);
+
+// Greedy Strips Following the List Order, Joined by stripRestart; Winding Matches the List
+std::vector<uint32_t> buildTriangleStrips(const std::vector<uint32_t>& indices);
+
+// Reorder Triangles, Then Vertices, Keeping Neighbour Links Intact; Reports ACMR Before and After
+void packTerrainMesh(TerrainMesh& mesh);
@@ -0,0 +1,393 @@
+//sources
+// Garland, M., Heckbert, P. S. (1997) Surface Simplification Using Quadric Error Metrics
+
+#include "MeshSimplifier.h"
+#include "MortonSort.h"
+#include "Parallel.h"
+#include "Profiling.h"
+#include "SurfaceQueries.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <queue>
+
+namespace 
+{
+    // Symmetric 4x4 Matrix Stored as Its Upper Triangle: xx xy xz xw yy yz yw zz zw ww
+    struct Quadric 
+    {
+        double q[10] = {};
+
+        void addPlane(double a, double b, double c, double d) 
+        {
+            double plane[4] = { a, b, c, d };
+            int k = 0;
+            for (int i = 0; i < 4; i++) 
+            {
+                for (int j = i; j < 4; j++) q[k++] += plane[i] * plane[j];
+            }
+        }
+
+        void add(const Quadric& other) 
+        {
+            for (int k = 0; k < 10; k++) q[k] += other.q[k];
+        }
+
+        double error(double x, double y, double z) const 
+        {
+            return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x + q[4] * y * y + 2.0 * q[5] * y * z +
+                   2.0 * q[6] * y + q[7] * z * z + 2.0 * q[8] * z + q[9];
+        }
+    };
+
+    // Positions Relative to the Mesh Corner So Quadrics Keep Their Precision
+    struct LocalPosition 
+    {
+        double x, y, z;
+    };
+
+    // State Shared by Every Tile of a Pass
+    struct SimplifyPass 
+    {
+        const std::vector<LocalPosition>* positions;
+        std::vector<Quadric>* quadrics;
+        const std::vector<uint8_t>* locked;
+        const std::vector<uint32_t>* indices;
+        double maxCost;
+    };
+
+    // Collapse of u Onto Its Neighbour v, Stale Once u's Stamp Moves On
+    struct Collapse 
+    {
+        double cost;
+        uint32_t u, v, stamp;
+
+        bool operator<(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    double orient(const LocalPosition& a, const LocalPosition& b, const LocalPosition& c) 
+    {
+        return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    }
+
+    // Simplify One Tile's Triangles Toward targetCount, Appending Survivors to output as Global Vertex Triples
+    void simplifyTile(const SimplifyPass& pass, const std::vector<uint32_t>& triangles, size_t targetCount, std::vector<uint32_t>& output) 
+    {
+        const std::vector<uint32_t>& indices = *pass.indices;
+
+        // Local Vertex Numbering
+        std::vector<uint32_t> vertices;
+        for (uint32_t t : triangles) vertices.insert(vertices.end(), { indices[3 * size_t(t)], indices[3 * size_t(t) + 1], indices[3 * size_t(t) + 2] });
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        auto localIndex = [&](uint32_t global) 
+        {
+            return static_cast<uint32_t>(std::lower_bound(vertices.begin(), vertices.end(), global) - vertices.begin());
+        };
+
+        size_t vertexCount = vertices.size(), triangleCount = triangles.size();
+        std::vector<uint32_t> corners(3 * triangleCount);
+        std::vector<std::vector<uint32_t>> around(vertexCount);
+        for (size_t t = 0; t < triangleCount; t++) 
+        {
+            for (int i = 0; i < 3; i++) 
+            {
+                corners[3 * t + i] = localIndex(indices[3 * size_t(triangles[t]) + i]);
+                around[corners[3 * t + i]].push_back(static_cast<uint32_t>(t));
+            }
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<LocalPosition> positions(vertexCount);
+        std::vector<uint8_t> fixed(vertexCount), removed(vertexCount, 0), alive(triangleCount, 1);
+        std::vector<uint32_t> stamps(vertexCount, 0);
+        for (size_t v = 0; v < vertexCount; v++) 
+        {
+            quadrics[v] = (*pass.quadrics)[vertices[v]];
+            positions[v] = (*pass.positions)[vertices[v]];
+            fixed[v] = (*pass.locked)[vertices[v]];
+        }
+
+        // Moving u Onto v Must Keep Every Remaining Triangle Counter-Clockwise in XY
+        auto collapseValid = [&](uint32_t u, uint32_t v) 
+        {
+            for (uint32_t t : around[u]) 
+            {
+                const uint32_t* c = &corners[3 * size_t(t)];
+                if (c[0] == v || c[1] == v || c[2] == v) continue;
+                LocalPosition p[3];
+                for (int i = 0; i < 3; i++) p[i] = positions[c[i] == u ? v : c[i]];
+                if (orient(p[0], p[1], p[2]) <= 0.0) return false;
+            }
+            return true;
+        };
+
+        // Queue u's Cheapest Valid Collapse; Validity Is Only Checked Until One Passes
+        std::priority_queue<Collapse> heap;
+        std::vector<std::pair<double, uint32_t>> candidates;
+        auto evaluate = [&](uint32_t u) 
+        {
+            stamps[u]++;
+            if (fixed[u] || removed[u]) return;
+            candidates.clear();
+            // u's Fan Is Closed, So the Corner After u Visits Every Neighbour Once
+            for (uint32_t t : around[u]) 
+            {
+                const uint32_t* c = &corners[3 * size_t(t)];
+                uint32_t v = c[0] == u ? c[1] : c[1] == u ? c[2] : c[0];
+                const LocalPosition& p = positions[v];
+                double cost = quadrics[u].error(p.x, p.y, p.z) + quadrics[v].error(p.x, p.y, p.z);
+                if (cost <= pass.maxCost) candidates.push_back({ cost, v });
+            }
+            std::sort(candidates.begin(), candidates.end());
+            for (size_t i = 0; i < candidates.size(); i++) 
+            {
+                if (!collapseValid(u, candidates[i].second)) continue;
+                heap.push({ candidates[i].first, u, candidates[i].second, stamps[u] });
+                return;
+            }
+        };
+        for (uint32_t v = 0; v < vertexCount; v++) evaluate(v);
+
+        size_t aliveCount = triangleCount;
+        std::vector<uint32_t> touched;
+        while (aliveCount > targetCount && !heap.empty()) 
+        {
+            Collapse collapse = heap.top();
+            heap.pop();
+            uint32_t u = collapse.u, v = collapse.v;
+            if (collapse.stamp != stamps[u] || removed[u] || removed[v] || !collapseValid(u, v)) continue;
+
+            // Triangles Sharing Edge uv Disappear, the Rest of u's Fan Moves Onto v
+            quadrics[v].add(quadrics[u]);
+            for (uint32_t t : around[u]) 
+            {
+                uint32_t* c = &corners[3 * size_t(t)];
+                if (c[0] == v || c[1] == v || c[2] == v) 
+                {
+                    alive[t] = 0;
+                    aliveCount--;
+                    for (int i = 0; i < 3; i++) 
+                    {
+                        if (c[i] == u) continue;
+                        std::vector<uint32_t>& list = around[c[i]];
+                        list.erase(std::find(list.begin(), list.end(), t));
+                    }
+                    continue;
+                }
+                for (int i = 0; i < 3; i++) 
+                {
+                    if (c[i] == u) c[i] = v;
+                }
+                around[v].push_back(t);
+            }
+            around[u].clear();
+            removed[u] = 1;
+
+            // Everything Touching v Saw Its Fan or Its Best Target Change
+            touched.clear();
+            for (uint32_t t : around[v]) touched.insert(touched.end(), corners.begin() + 3 * size_t(t), corners.begin() + 3 * size_t(t) + 3);
+            std::sort(touched.begin(), touched.end());
+            touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+            for (uint32_t w : touched) evaluate(w);
+        }
+
+        for (size_t v = 0; v < vertexCount; v++) (*pass.quadrics)[vertices[v]] = quadrics[v];
+        for (size_t t = 0; t < triangleCount; t++) 
+        {
+            if (!alive[t]) continue;
+            for (int i = 0; i < 3; i++) output.push_back(vertices[corners[3 * t + i]]);
+        }
+    }
+
+    // One Round Over a Tile Grid Shifted by offset Tiles; Triangles Spanning Tiles Lock Their Vertices and Pass Through
+    std::vector<uint32_t> runPass(const std::vector<LocalPosition>& positions, std::vector<Quadric>& quadrics,
+                                  const std::vector<uint8_t>& boundary, const std::vector<uint32_t>& indices, const Bounds& bounds,
+                                  const SimplifySettings& settings, double maxCost, float offset) 
+    {
+        size_t triangleCount = indices.size() / 3;
+        double width = std::max(double(bounds.maxX) - bounds.minX, 1e-6), depth = std::max(double(bounds.maxY) - bounds.minY, 1e-6);
+        double tileSize = std::sqrt(width * depth * std::max<size_t>(settings.tileTriangles, 64) / std::max<size_t>(triangleCount, 1));
+        uint32_t tileColumns = static_cast<uint32_t>(width / tileSize) + 2, tileRows = static_cast<uint32_t>(depth / tileSize) + 2;
+
+        std::vector<uint32_t> vertexTile(positions.size());
+        parallelFor(positions.size(), [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t v = begin; v < end; v++) 
+            {
+                uint32_t column = static_cast<uint32_t>(positions[v].x / tileSize + offset);
+                uint32_t row = static_cast<uint32_t>(positions[v].y / tileSize + offset);
+                vertexTile[v] = std::min(row, tileRows - 1) * tileColumns + std::min(column, tileColumns - 1);
+            }
+        });
+
+        std::vector<uint8_t> locked = boundary;
+        std::vector<std::vector<uint32_t>> tiles(size_t(tileColumns) * tileRows);
+        std::vector<uint32_t> result;
+        for (size_t t = 0; t < triangleCount; t++) 
+        {
+            const uint32_t* c = &indices[3 * t];
+            uint32_t tile = vertexTile[c[0]];
+            if (vertexTile[c[1]] == tile && vertexTile[c[2]] == tile) 
+            {
+                tiles[tile].push_back(static_cast<uint32_t>(t));
+                continue;
+            }
+            locked[c[0]] = locked[c[1]] = locked[c[2]] = 1;
+            result.insert(result.end(), c, c + 3);
+        }
+
+        // Spread What the Target Still Allows Over the Tiles in Proportion to Their Size
+        size_t spanning = result.size() / 3;
+        double keep = 0.0;
+        if (settings.targetTriangles > 0 && triangleCount > spanning) keep = std::max(0.0, double(settings.targetTriangles) - spanning) / (triangleCount - spanning);
+        else if (settings.targetTriangles > 0) keep = 1.0;
+
+        SimplifyPass pass = { &positions, &quadrics, &locked, &indices, maxCost };
+        std::vector<std::vector<uint32_t>> outputs(tiles.size());
+        parallelTasks(tiles.size(), [&](size_t tile, unsigned) 
+        {
+            if (tiles[tile].empty()) return;
+            size_t target = static_cast<size_t>(std::ceil(tiles[tile].size() * keep));
+            simplifyTile(pass, tiles[tile], target, outputs[tile]);
+        });
+        for (const std::vector<uint32_t>& output : outputs) result.insert(result.end(), output.begin(), output.end());
+        return result;
+    }
+
+    // Pair Up Half-Edges by Sorting Their Vertex Pairs
+    void buildNeighbors(TerrainMesh& mesh) 
+    {
+        size_t halfEdges = mesh.indices.size();
+        std::vector<uint64_t> keys(halfEdges);
+        std::vector<uint32_t> edges(halfEdges);
+        mesh.neighbors.assign(halfEdges, noTriangle);
+        parallelFor(halfEdges, [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t e = begin; e < end; e++) 
+            {
+                size_t t = e / 3;
+                int i = static_cast<int>(e % 3);
+                uint64_t a = mesh.indices[3 * t + (i + 1) % 3], b = mesh.indices[3 * t + (i + 2) % 3];
+                keys[e] = std::min(a, b) << 32 | std::max(a, b);
+                edges[e] = static_cast<uint32_t>(e);
+            }
+        });
+        radixSortPairs(keys, edges);
+        for (size_t k = 0; k + 1 < halfEdges; k++) 
+        {
+            if (keys[k] != keys[k + 1]) continue;
+            mesh.neighbors[edges[k]] = edges[k + 1] / 3;
+            mesh.neighbors[edges[k + 1]] = edges[k] / 3;
+            k++;
+        }
+    }
+}
+
+bool simplifyMesh(const TerrainMesh& input, const SimplifySettings& settings, TerrainMesh& output) 
+{
+    if (settings.targetTriangles == 0 && !(settings.maxError > 0.0f)) 
+    {
+        std::cerr << "Simplification needs a target triangle count or an error tolerance" << std::endl;
+        return false;
+    }
+
+    Stopwatch timer;
+    Bounds bounds = emptyBounds();
+    for (const Point& v : input.vertices) includePoint(bounds, v);
+    size_t vertexCount = input.vertices.size(), triangleCount = input.triangleCount();
+    std::vector<LocalPosition> positions(vertexCount);
+    parallelFor(vertexCount, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t v = begin; v < end; v++) 
+        {
+            const Point& p = input.vertices[v];
+            positions[v] = { double(p.x) - bounds.minX, double(p.y) - bounds.minY, double(p.z) - bounds.minZ };
+        }
+    });
+
+    // Each Vertex Starts With the Planes of Its Triangles; Hull Vertices Never Move
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<uint8_t> boundary(vertexCount, 0);
+    for (size_t t = 0; t < triangleCount; t++) 
+    {
+        const uint32_t* c = &input.indices[3 * t];
+        const LocalPosition& a = positions[c[0]];
+        const LocalPosition& b = positions[c[1]];
+        const LocalPosition& d = positions[c[2]];
+        double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z, vx = d.x - a.x, vy = d.y - a.y, vz = d.z - a.z;
+        double nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+        double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (length > 0.0) 
+        {
+            nx /= length, ny /= length, nz /= length;
+            Quadric plane;
+            plane.addPlane(nx, ny, nz, -(nx * a.x + ny * a.y + nz * a.z));
+            for (int i = 0; i < 3; i++) quadrics[c[i]].add(plane);
+        }
+        for (int i = 0; i < 3; i++) 
+        {
+            if (input.neighbors[3 * t + i] == noTriangle) boundary[c[(i + 1) % 3]] = boundary[c[(i + 2) % 3]] = 1;
+        }
+    }
+
+    double maxCost = settings.maxError > 0.0f ? double(settings.maxError) * settings.maxError : std::numeric_limits<double>::infinity();
+    std::vector<uint32_t> indices = runPass(positions, quadrics, boundary, input.indices, bounds, settings, maxCost, 0.0f);
+    indices = runPass(positions, quadrics, boundary, indices, bounds, settings, maxCost, 0.5f);
+
+    // Keep Surviving Vertices in Input Order
+    std::vector<uint32_t> remap(vertexCount, noTriangle);
+    for (uint32_t v : indices) remap[v] = 0;
+    output = TerrainMesh();
+    for (size_t v = 0; v < vertexCount; v++) 
+    {
+        if (remap[v] == noTriangle) continue;
+        remap[v] = static_cast<uint32_t>(output.vertices.size());
+        output.vertices.push_back(input.vertices[v]);
+    }
+    for (uint32_t& v : indices) v = remap[v];
+    output.indices = std::move(indices);
+    buildNeighbors(output);
+
+    std::cout << "Simplified " << triangleCount << " to " << output.triangleCount() << " triangles ("
+              << 100.0 * output.triangleCount() / std::max<size_t>(triangleCount, 1) << "%), " << output.vertices.size() << " vertices"
+              << std::endl;
+    reportThroughput("Simplification", triangleCount, timer.seconds(), "triangles");
+    return true;
+}
+
+SurfaceError measureSurfaceError(const TerrainMesh& original, const TerrainMesh& simplified) 
+{
+    SurfaceError error;
+    TriangleGrid grid;
+    if (!buildTriangleGrid(simplified, grid)) return error;
+
+    size_t count = original.vertices.size();
+    std::vector<PlanePoint> queries(count);
+    std::vector<SurfaceSample> samples(count);
+    for (size_t v = 0; v < count; v++) 
+    {
+        queries[v] = { original.vertices[v].x, original.vertices[v].y };
+        samples[v].triangle = noTriangle;
+    }
+    sampleSurfaceBatch(simplified, grid, queries.data(), count, samples.data());
+
+    double sum = 0.0;
+    size_t inside = 0;
+    for (size_t v = 0; v < count; v++) 
+    {
+        if (samples[v].triangle == noTriangle) 
+        {
+            error.outside++;
+            continue;
+        }
+        float difference = std::fabs(samples[v].height - original.vertices[v].z);
+        error.maximum = std::max(error.maximum, difference);
+        sum += difference;
+        inside++;
+    }
+    error.mean = inside > 0 ? static_cast<float>(sum / inside) : 0.0f;
+    return error;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Delaunay.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// When to Stop Collapsing; Zero Disables a Limit, at Least One Must Be Set
+struct SimplifySettings 
+{
+    size_t targetTriangles = 0;                  // Stop Once the Mesh Is This Small
+    float maxError = 0.0f;                       // Largest Quadric Error, as a Distance in Map Units
+    size_t tileTriangles = 65536;                // Triangles per Parallel Tile
+};
+
+// Vertical Distance From the Input Vertices to the Simplified Surface
+struct SurfaceError 
+{
+    float maximum = 0.0f;
+    float mean = 0.0f;
+    size_t outside = 0;
+};
+
+// Quadric Error Edge Collapses in Parallel Tiles; Mesh Boundaries and Tile Borders Stay Fixed, a Second Pass on Shifted
+// Tiles Frees the Borders; Surviving Vertices Keep Their Positions
+bool simplifyMesh(const TerrainMesh& input, const SimplifySettings& settings, TerrainMesh& output);
+
+// Sample the Simplified Surface Under Every Input Vertex
+SurfaceError measureSurfaceError(const TerrainMesh& original, const TerrainMesh& simplified);
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+// Spread the Low 21 Bits of v So Two Zero Bits Follow Each One
+inline uint64_t spreadBits3(uint64_t v) 
+{
+    v &= 0x1FFFFF;
+    v = (v | v << 32) & 0x1F00000000FFFFull;
+    v = (v | v << 16) & 0x1F0000FF0000FFull;
+    v = (v | v << 8) & 0x100F00F00F00F00Full;
+    v = (v | v << 4) & 0x10C30C30C30C30C3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+// Inverse of spreadBits3
+inline uint32_t compactBits3(uint64_t v) 
+{
+    v &= 0x1249249249249249ull;
+    v = (v ^ (v >> 2)) & 0x10C30C30C30C30C3ull;
+    v = (v ^ (v >> 4)) & 0x100F00F00F00F00Full;
+    v = (v ^ (v >> 8)) & 0x1F0000FF0000FFull;
+    v = (v ^ (v >> 16)) & 0x1F00000000FFFFull;
+    v = (v ^ (v >> 32)) & 0x1FFFFF;
+    return static_cast<uint32_t>(v);
+}
+
+// Interleave 21-Bit Cell Coordinates Into a Z-Order Code (x in the Lowest Bit)
+inline uint64_t mortonEncode3(uint32_t x, uint32_t y, uint32_t z) 
+{
+    return spreadBits3(x) | spreadBits3(y) << 1 | spreadBits3(z) << 2;
+}
+
+inline void mortonDecode3(uint64_t code, uint32_t& x, uint32_t& y, uint32_t& z) 
+{
+    x = compactBits3(code);
+    y = compactBits3(code >> 1);
+    z = compactBits3(code >> 2);
+}
+
+// Spread the Low 32 Bits of v So One Zero Bit Follows Each One
+inline uint64_t spreadBits2(uint64_t v) 
+{
+    v &= 0xFFFFFFFFull;
+    v = (v | v << 16) & 0x0000FFFF0000FFFFull;
+    v = (v | v << 8) & 0x00FF00FF00FF00FFull;
+    v = (v | v << 4) & 0x0F0F0F0F0F0F0F0Full;
+    v = (v | v << 2) & 0x3333333333333333ull;
+    v = (v | v << 1) & 0x5555555555555555ull;
+    return v;
+}
+
+// Interleave Two 32-Bit Coordinates Into a Z-Order Code (x in the Lowest Bit)
+inline uint64_t mortonEncode2(uint32_t x, uint32_t y) 
+{
+    return spreadBits2(x) | spreadBits2(y) << 1;
+}
@@ -0,0 +1,123 @@
+#include "MortonSort.h"
+#include "Morton.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+
+#include <algorithm>
+
+namespace 
+{
+    const int radixBits = 8;
+    const size_t radixBuckets = size_t(1) << radixBits;
+    const uint32_t mortonCells = 1u << 21;
+
+    uint32_t gridCoordinate(float value, float minimum, float scale) 
+    {
+        float f = (value - minimum) * scale;
+        if (!(f > 0.0f)) return 0;
+        return f >= mortonCells ? mortonCells - 1 : static_cast<uint32_t>(f);
+    }
+
+    template <typename T>
+    void gather(std::vector<T>& values, const std::vector<uint32_t>& order) 
+    {
+        if (values.size() != order.size()) return;
+        std::vector<T> sorted(values.size());
+        parallelFor(order.size(), [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t i = begin; i < end; i++) sorted[i] = values[order[i]];
+        });
+        values.swap(sorted);
+    }
+}
+
+void computeMortonCodes(const Point* points, size_t count, const Bounds& bounds, uint64_t* codes) 
+{
+    float size = std::max({ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY, bounds.maxZ - bounds.minZ });
+    float scale = size > 0.0f ? mortonCells / size : 0.0f;
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            const Point& p = points[i];
+            codes[i] = mortonEncode3(gridCoordinate(p.x, bounds.minX, scale), gridCoordinate(p.y, bounds.minY, scale),
+                                     gridCoordinate(p.z, bounds.minZ, scale));
+        }
+    });
+}
+
+void radixSortPairs(std::vector<uint64_t>& keys, std::vector<uint32_t>& values) 
+{
+    size_t count = keys.size();
+    std::vector<uint64_t> keyBuffer(count);
+    std::vector<uint32_t> valueBuffer(count);
+    unsigned workers = workerCount();
+    std::vector<size_t> histograms(workers * radixBuckets);
+
+    for (int shift = 0; shift < 64; shift += radixBits) 
+    {
+        // Per-Worker Histograms Over the Same Slices parallelFor Hands Out Below
+        std::fill(histograms.begin(), histograms.end(), 0);
+        parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+        {
+            size_t* histogram = histograms.data() + worker * radixBuckets;
+            for (size_t i = begin; i < end; i++) histogram[keys[i] >> shift & (radixBuckets - 1)]++;
+        });
+
+        // Exclusive Offsets, Bucket-Major Then Worker, Keep the Sort Stable
+        size_t offset = 0;
+        bool skip = false;
+        for (size_t bucket = 0; bucket < radixBuckets; bucket++) 
+        {
+            size_t bucketStart = offset;
+            for (unsigned worker = 0; worker < workers; worker++) 
+            {
+                size_t& entry = histograms[worker * radixBuckets + bucket];
+                size_t bucketCount = entry;
+                entry = offset;
+                offset += bucketCount;
+            }
+            if (offset - bucketStart == count) skip = true;
+        }
+        if (skip) continue;
+
+        parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+        {
+            size_t* next = histograms.data() + worker * radixBuckets;
+            for (size_t i = begin; i < end; i++) 
+            {
+                size_t slot = next[keys[i] >> shift & (radixBuckets - 1)]++;
+                keyBuffer[slot] = keys[i];
+                valueBuffer[slot] = values[i];
+            }
+        });
+        keys.swap(keyBuffer);
+        values.swap(valueBuffer);
+    }
+}
+
+void sortPointsMorton(std::vector<Point>& points, PointAttributes& attributes, const Bounds& bounds) 
+{
+    std::vector<uint64_t> codes(points.size());
+    std::vector<uint32_t> order(points.size());
+    computeMortonCodes(points.data(), points.size(), bounds, codes.data());
+    for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<uint32_t>(i);
+    radixSortPairs(codes, order);
+
+    gather(points, order);
+    gather(attributes.intensity, order);
+    gather(attributes.classification, order);
+    gather(attributes.returnNumber, order);
+}
+
+std::vector<PointSlice> slicePoints(const Point* points, size_t count, size_t pointsPerSlice) 
+{
+    std::vector<PointSlice> slices((count + pointsPerSlice - 1) / pointsPerSlice);
+    parallelTasks(slices.size(), [&](size_t s, unsigned) 
+    {
+        size_t first = s * pointsPerSlice;
+        size_t sliceCount = std::min(pointsPerSlice, count - first);
+        slices[s] = { computeBounds(points + first, sliceCount), first, sliceCount };
+    });
+    return slices;
+}
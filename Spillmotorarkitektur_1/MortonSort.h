@@ -0,0 +1,32 @@
+//sources
+// Morton - A Computer Oriented Geodetic Data Base and a New Technique in File Sequencing (1966)
+// Satish, Harris, Garland - Designing Efficient Sorting Algorithms for Manycore GPUs (2009)
+
+#pragma once
+
+#include "LasReader.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Contiguous Run of Points and the Box Around Them
+struct PointSlice 
+{
+    Bounds bounds;
+    size_t first;
+    size_t count;
+};
+
+// 63-Bit Z-Order Codes of Points on a 2^21 Grid Over the Cube Enclosing bounds
+void computeMortonCodes(const Point* points, size_t count, const Bounds& bounds, uint64_t* codes);
+
+// Parallel LSD Radix Sort of Keys, Carrying values Along; Bytes Shared by All Keys Are Skipped
+void radixSortPairs(std::vector<uint64_t>& keys, std::vector<uint32_t>& values);
+
+// Reorder Points and Any Attributes of Matching Size Along the Z-Curve
+void sortPointsMorton(std::vector<Point>& points, PointAttributes& attributes, const Bounds& bounds);
+
+// Cut Points Into Fixed-Size Runs With Their Bounds, Tight Once Points Are Morton Sorted
+std::vector<PointSlice> slicePoints(const Point* points, size_t count, size_t pointsPerSlice);
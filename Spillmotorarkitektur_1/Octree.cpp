@@ -0,0 +1,75 @@
+#include "Octree.h"
+
+#include <bitset>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace 
+{
+    const char octreeMagic[8] = { 'V', 'O', 'S', 'O', 'C', 'T', '\0', '\0' };
+    const uint32_t octreeVersion = 1;
+}
+
+std::string octreeHierarchyPath(const std::string& directory) 
+{
+    return (std::filesystem::path(directory) / "hierarchy.bin").string();
+}
+
+std::string octreePointsPath(const std::string& directory) 
+{
+    return (std::filesystem::path(directory) / "octree.bin").string();
+}
+
+int octreeChild(const std::vector<OctreeNode>& nodes, uint32_t node, int octant) 
+{
+    uint8_t mask = nodes[node].childMask;
+    if (!(mask & (1 << octant))) return -1;
+    size_t before = std::bitset<8>(mask & ((1u << octant) - 1)).count();
+    return static_cast<int>(nodes[node].firstChild + before);
+}
+
+bool loadOctreeHierarchy(const std::string& directory, OctreeHeader& header, std::vector<OctreeNode>& nodes) 
+{
+    std::ifstream file(octreeHierarchyPath(directory), std::ios::binary);
+    if (!file.is_open()) 
+    {
+        std::cerr << "Failed to open octree: " << directory << std::endl;
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, octreeMagic, sizeof(octreeMagic)) != 0 || header.version != octreeVersion) 
+    {
+        std::cerr << "Not a supported octree: " << directory << std::endl;
+        return false;
+    }
+
+    nodes.resize(header.nodeCount);
+    file.read(reinterpret_cast<char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(OctreeNode)));
+    if (!file) 
+    {
+        std::cerr << "Octree hierarchy is truncated: " << directory << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool writeOctreeHierarchy(const std::string& directory, const OctreeHeader& header, const std::vector<OctreeNode>& nodes) 
+{
+    std::ofstream file(octreeHierarchyPath(directory), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) 
+    {
+        std::cerr << "Failed to write octree hierarchy: " << directory << std::endl;
+        return false;
+    }
+
+    OctreeHeader stamped = header;
+    std::memcpy(stamped.magic, octreeMagic, sizeof(octreeMagic));
+    stamped.version = octreeVersion;
+    stamped.nodeCount = static_cast<uint32_t>(nodes.size());
+    file.write(reinterpret_cast<const char*>(&stamped), sizeof(stamped));
+    file.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(nodes.size() * sizeof(OctreeNode)));
+    return static_cast<bool>(file);
+}
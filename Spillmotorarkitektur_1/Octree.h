@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// hierarchy.bin Header
+struct OctreeHeader 
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t nodeCount;
+    uint64_t pointCount;
+    Bounds cube;
+    float spacing;
+    uint32_t reserved;
+};
+
+// Node Record in hierarchy.bin, Children of a Node Are Stored Contiguously in Octant Order
+struct OctreeNode 
+{
+    Bounds bounds;
+    uint64_t byteOffset;
+    uint32_t pointCount;
+    uint32_t firstChild;
+    uint8_t childMask;
+    uint8_t level;
+    uint16_t reserved;
+};
+
+// Files Inside an Octree Directory
+std::string octreeHierarchyPath(const std::string& directory);
+std::string octreePointsPath(const std::string& directory);
+
+// Index of a Node's Child in Octant o, or -1
+int octreeChild(const std::vector<OctreeNode>& nodes, uint32_t node, int octant);
+
+// Read and Write the Node Hierarchy
+bool loadOctreeHierarchy(const std::string& directory, OctreeHeader& header, std::vector<OctreeNode>& nodes);
+bool writeOctreeHierarchy(const std::string& directory, const OctreeHeader& header, const std::vector<OctreeNode>& nodes);
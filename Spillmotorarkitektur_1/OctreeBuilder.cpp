@@ -0,0 +1,454 @@
+//sources
+// Schuetz, Ohrhallinger, Wimmer - Fast Out-of-Core Octree Generation for Massive Point Clouds (2020)
+
+#include "OctreeBuilder.h"
+#include "Morton.h"
+#include "Octree.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+#include "PointStream.h"
+#include "Profiling.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace 
+{
+    const int maxOctreeLevel = 19;
+
+    // Level in the Top Bits, Morton Code of the Node Cell Below
+    uint64_t nodeKey(int level, uint64_t morton) { return (uint64_t(level) << 58) | morton; }
+    int keyLevel(uint64_t key) { return static_cast<int>(key >> 58); }
+    uint64_t keyMorton(uint64_t key) { return key & ((uint64_t(1) << 58) - 1); }
+
+    // Node Written to octree.bin
+    struct BuiltNode 
+    {
+        uint64_t key;
+        uint64_t byteOffset;
+        uint32_t pointCount;
+    };
+
+    // Subtree Handed to One Worker
+    struct Chunk 
+    {
+        int level;
+        uint64_t morton;
+        uint64_t pointCount;
+    };
+
+    struct BuildContext 
+    {
+        explicit BuildContext(const OctreeBuildSettings& buildSettings) : settings(buildSettings) {}
+
+        const OctreeBuildSettings& settings;
+        Bounds cube = {};
+        float size = 1.0f;
+
+        std::mutex writeMutex;
+        std::ofstream pointsFile;
+        uint64_t writeOffset = 0;
+        std::vector<BuiltNode> nodes;
+    };
+
+    uint32_t cellCoordinate(float value, float min, float scale, uint32_t cells) 
+    {
+        float f = (value - min) * scale;
+        if (!(f > 0.0f)) return 0;
+        return f >= cells ? cells - 1 : static_cast<uint32_t>(f);
+    }
+
+    // Morton Code of the Cell Containing p at a Level of the Whole Cube
+    uint64_t cellMorton(const BuildContext& context, const Point& p, int level) 
+    {
+        uint32_t cells = 1u << level;
+        float scale = cells / context.size;
+        return mortonEncode3(cellCoordinate(p.x, context.cube.minX, scale, cells),
+                             cellCoordinate(p.y, context.cube.minY, scale, cells),
+                             cellCoordinate(p.z, context.cube.minZ, scale, cells));
+    }
+
+    Bounds nodeBounds(const BuildContext& context, int level, uint64_t morton) 
+    {
+        uint32_t ix, iy, iz;
+        mortonDecode3(morton, ix, iy, iz);
+        float nodeSize = context.size / (1u << level);
+        Bounds bounds;
+        bounds.minX = context.cube.minX + ix * nodeSize;
+        bounds.minY = context.cube.minY + iy * nodeSize;
+        bounds.minZ = context.cube.minZ + iz * nodeSize;
+        bounds.maxX = bounds.minX + nodeSize;
+        bounds.maxY = bounds.minY + nodeSize;
+        bounds.maxZ = bounds.minZ + nodeSize;
+        return bounds;
+    }
+
+    // Append a Node's Points to octree.bin
+    void writeNode(BuildContext& context, uint64_t key, const Point* points, size_t count) 
+    {
+        std::lock_guard<std::mutex> lock(context.writeMutex);
+        context.nodes.push_back({ key, context.writeOffset, static_cast<uint32_t>(count) });
+        context.pointsFile.write(reinterpret_cast<const char*>(points), static_cast<std::streamsize>(count * sizeof(Point)));
+        context.writeOffset += count * sizeof(Point);
+    }
+
+    // Sample Cell of p Inside a Node, Flattened
+    uint32_t sampleCell(const Bounds& bounds, float scale, int grid, const Point& p) 
+    {
+        uint32_t cx = cellCoordinate(p.x, bounds.minX, scale, grid);
+        uint32_t cy = cellCoordinate(p.y, bounds.minY, scale, grid);
+        uint32_t cz = cellCoordinate(p.z, bounds.minZ, scale, grid);
+        return (cz * grid + cy) * grid + cx;
+    }
+
+    // Move the First Point of Every Occupied Sample Cell From source to samples
+    void takeSamples(const BuildContext& context, int level, uint64_t morton, std::vector<Point>& source,
+                     std::vector<Point>& samples, std::vector<uint64_t>& occupied) 
+    {
+        int grid = context.settings.sampleGrid;
+        Bounds bounds = nodeBounds(context, level, morton);
+        float scale = grid / (bounds.maxX - bounds.minX);
+
+        size_t first = samples.size();
+        size_t remaining = 0;
+        for (const Point& p : source) 
+        {
+            uint32_t cell = sampleCell(bounds, scale, grid, p);
+            uint64_t bit = uint64_t(1) << (cell & 63);
+            if (occupied[cell >> 6] & bit) 
+            {
+                source[remaining++] = p;
+            }
+            else 
+            {
+                occupied[cell >> 6] |= bit;
+                samples.push_back(p);
+            }
+        }
+        source.resize(remaining);
+
+        for (size_t i = first; i < samples.size(); i++) 
+        {
+            occupied[sampleCell(bounds, scale, grid, samples[i]) >> 6] = 0;
+        }
+    }
+
+    // Subsample in Place: Kept Points Move to the Front, Returns How Many
+    size_t selectSamples(const BuildContext& context, int level, uint64_t morton, Point* points, size_t count,
+                         std::vector<uint64_t>& occupied) 
+    {
+        int grid = context.settings.sampleGrid;
+        Bounds bounds = nodeBounds(context, level, morton);
+        float scale = grid / (bounds.maxX - bounds.minX);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) 
+        {
+            uint32_t cell = sampleCell(bounds, scale, grid, points[i]);
+            uint64_t bit = uint64_t(1) << (cell & 63);
+            if (!(occupied[cell >> 6] & bit)) 
+            {
+                occupied[cell >> 6] |= bit;
+                std::swap(points[i], points[kept++]);
+            }
+        }
+
+        for (size_t i = 0; i < kept; i++) 
+        {
+            occupied[sampleCell(bounds, scale, grid, points[i]) >> 6] = 0;
+        }
+        return kept;
+    }
+
+    // Build a Node and Its Descendants; the Chunk Root Stays in root for the Upper Levels
+    void buildNode(BuildContext& context, int level, uint64_t morton, Point* points, size_t count,
+                   std::vector<uint64_t>& occupied, std::vector<Point>* root) 
+    {
+        size_t kept = count;
+        if (count > context.settings.maxNodePoints && level < maxOctreeLevel) 
+        {
+            kept = selectSamples(context, level, morton, points, count, occupied);
+        }
+
+        if (root) root->assign(points, points + kept);
+        else writeNode(context, nodeKey(level, morton), points, kept);
+        if (kept == count) return;
+
+        // Sort the Rest Into Octants: z Half, Then y, Then x
+        Point* begin = points + kept;
+        Point* end = points + count;
+        auto octantOf = [&](const Point& p) { return static_cast<int>(cellMorton(context, p, level + 1) & 7); };
+        Point* split[9];
+        split[0] = begin;
+        split[8] = end;
+        split[4] = std::partition(begin, end, [&](const Point& p) { return !(octantOf(p) & 4); });
+        for (int half = 0; half < 8; half += 4) 
+        {
+            split[half + 2] = std::partition(split[half], split[half + 4], [&](const Point& p) { return !(octantOf(p) & 2); });
+            for (int quarter = half; quarter < half + 4; quarter += 2) 
+            {
+                split[quarter + 1] = std::partition(split[quarter], split[quarter + 2], [&](const Point& p) { return !(octantOf(p) & 1); });
+            }
+        }
+
+        for (int octant = 0; octant < 8; octant++) 
+        {
+            size_t childCount = split[octant + 1] - split[octant];
+            if (childCount > 0) 
+            {
+                buildNode(context, level + 1, morton << 3 | octant, split[octant], childCount, occupied, nullptr);
+            }
+        }
+    }
+
+    std::string chunkPath(const std::filesystem::path& directory, size_t chunk) 
+    {
+        return (directory / ("c" + std::to_string(chunk) + ".bin")).string();
+    }
+}
+
+bool buildOctree(const std::string& input, const std::string& outputDirectory, const OctreeBuildSettings& settings) 
+{
+    Stopwatch totalTimer;
+    PointStream stream;
+    if (!openPointStream(input, stream, settings.batchPoints)) return false;
+
+    std::filesystem::path chunkDirectory = std::filesystem::path(outputDirectory) / "chunks";
+    std::error_code error;
+    std::filesystem::create_directories(chunkDirectory, error);
+    if (error) 
+    {
+        std::cerr << "Failed to create octree directory: " << outputDirectory << std::endl;
+        return false;
+    }
+
+    // Pass 1: Bounds and Point Count
+    Stopwatch passTimer;
+    Bounds bounds = emptyBounds();
+    uint64_t totalPoints = 0;
+    std::vector<Point> batch;
+    std::vector<Bounds> workerBounds(workerCount());
+    while (size_t count = readPointBatch(stream, batch)) 
+    {
+        std::fill(workerBounds.begin(), workerBounds.end(), emptyBounds());
+        parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+        {
+            includeBounds(workerBounds[worker], computeBounds(batch.data() + begin, end - begin));
+        });
+        for (const Bounds& b : workerBounds) includeBounds(bounds, b);
+        totalPoints += count;
+    }
+
+    if (totalPoints == 0) 
+    {
+        std::cerr << "No Points Loaded" << std::endl;
+        return false;
+    }
+    reportThroughput("Octree bounds pass", static_cast<size_t>(totalPoints), passTimer.seconds());
+
+    BuildContext context(settings);
+    context.size = std::max({ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY, bounds.maxZ - bounds.minZ });
+    if (context.size == 0.0f) context.size = 1.0f;
+    context.cube = { bounds.minX, bounds.minY, bounds.minZ,
+                     bounds.minX + context.size, bounds.minY + context.size, bounds.minZ + context.size };
+
+    // Pass 2: Count Points per Cell of the Counting Grid
+    passTimer = Stopwatch();
+    int gridLevels = std::min(settings.countingGridLevels, maxOctreeLevel);
+    size_t cellCount = size_t(1) << (3 * gridLevels);
+    std::vector<std::vector<uint64_t>> pyramid(gridLevels + 1);
+    pyramid[gridLevels].assign(cellCount, 0);
+    std::vector<uint32_t> cellOf;
+    rewindPointStream(stream);
+    while (size_t count = readPointBatch(stream, batch)) 
+    {
+        cellOf.resize(count);
+        parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t i = begin; i < end; i++) cellOf[i] = static_cast<uint32_t>(cellMorton(context, batch[i], gridLevels));
+        });
+        for (uint32_t cell : cellOf) pyramid[gridLevels][cell]++;
+    }
+    for (int level = gridLevels; level > 0; level--) 
+    {
+        pyramid[level - 1].assign(pyramid[level].size() / 8, 0);
+        for (size_t cell = 0; cell < pyramid[level].size(); cell++) pyramid[level - 1][cell >> 3] += pyramid[level][cell];
+    }
+
+    // Merge Cells Top-Down Into Chunks That Fit in Memory
+    std::vector<Chunk> chunks;
+    std::vector<uint32_t> chunkOfCell(cellCount, 0);
+    std::vector<std::pair<int, uint64_t>> pending = { { 0, 0 } };
+    while (!pending.empty()) 
+    {
+        auto [level, morton] = pending.back();
+        pending.pop_back();
+        uint64_t count = pyramid[level][morton];
+        if (count == 0) continue;
+
+        if (count > settings.maxChunkPoints && level < gridLevels) 
+        {
+            for (int octant = 7; octant >= 0; octant--) pending.push_back({ level + 1, morton << 3 | octant });
+            continue;
+        }
+
+        int shift = 3 * (gridLevels - level);
+        std::fill(chunkOfCell.begin() + (morton << shift), chunkOfCell.begin() + ((morton + 1) << shift),
+                  static_cast<uint32_t>(chunks.size()));
+        chunks.push_back({ level, morton, count });
+    }
+    pyramid.clear();
+    std::cout << "Octree counting pass: " << chunks.size() << " chunks in " << passTimer.seconds() * 1000.0 << " ms" << std::endl;
+
+    // Pass 3: Distribute Points Into Per-Chunk Files
+    passTimer = Stopwatch();
+    std::vector<Point> sorted;
+    std::vector<size_t> chunkStart(chunks.size() + 1);
+    rewindPointStream(stream);
+    while (size_t count = readPointBatch(stream, batch)) 
+    {
+        cellOf.resize(count);
+        parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t i = begin; i < end; i++) cellOf[i] = chunkOfCell[cellMorton(context, batch[i], gridLevels)];
+        });
+
+        std::fill(chunkStart.begin(), chunkStart.end(), 0);
+        for (uint32_t chunk : cellOf) chunkStart[chunk + 1]++;
+        for (size_t c = 0; c < chunks.size(); c++) chunkStart[c + 1] += chunkStart[c];
+
+        sorted.resize(count);
+        std::vector<size_t> cursor(chunkStart.begin(), chunkStart.end() - 1);
+        for (size_t i = 0; i < count; i++) sorted[cursor[cellOf[i]]++] = batch[i];
+
+        for (size_t c = 0; c < chunks.size(); c++) 
+        {
+            if (chunkStart[c + 1] == chunkStart[c]) continue;
+            std::ofstream file(chunkPath(chunkDirectory, c), std::ios::binary | std::ios::app);
+            file.write(reinterpret_cast<const char*>(sorted.data() + chunkStart[c]),
+                       static_cast<std::streamsize>((chunkStart[c + 1] - chunkStart[c]) * sizeof(Point)));
+            if (!file) 
+            {
+                std::cerr << "Failed to write octree chunk: " << chunkPath(chunkDirectory, c) << std::endl;
+                return false;
+            }
+        }
+    }
+    std::vector<Point>().swap(batch);
+    std::vector<Point>().swap(sorted);
+    std::vector<uint32_t>().swap(cellOf);
+    std::vector<uint32_t>().swap(chunkOfCell);
+    reportThroughput("Octree distribution pass", static_cast<size_t>(totalPoints), passTimer.seconds());
+
+    // Pass 4: Build Each Chunk's Subtree in Parallel
+    passTimer = Stopwatch();
+    context.pointsFile.open(octreePointsPath(outputDirectory), std::ios::binary | std::ios::trunc);
+    if (!context.pointsFile.is_open()) 
+    {
+        std::cerr << "Failed to write octree points: " << outputDirectory << std::endl;
+        return false;
+    }
+
+    size_t gridWords = (size_t(settings.sampleGrid) * settings.sampleGrid * settings.sampleGrid + 63) / 64;
+    std::vector<std::vector<uint64_t>> occupied(workerCount(), std::vector<uint64_t>(gridWords, 0));
+    std::map<uint64_t, std::vector<Point>> roots;
+    for (const Chunk& chunk : chunks) roots[nodeKey(chunk.level, chunk.morton)];
+
+    parallelTasks(chunks.size(), [&](size_t c, unsigned worker) 
+    {
+        std::string path = chunkPath(chunkDirectory, c);
+        std::vector<Point> points(static_cast<size_t>(chunks[c].pointCount));
+        {
+            std::ifstream file(path, std::ios::binary);
+            file.read(reinterpret_cast<char*>(points.data()), static_cast<std::streamsize>(points.size() * sizeof(Point)));
+        }
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+
+        std::vector<Point>& root = roots.at(nodeKey(chunks[c].level, chunks[c].morton));
+        buildNode(context, chunks[c].level, chunks[c].morton, points.data(), points.size(), occupied[worker], &root);
+    });
+    std::filesystem::remove_all(chunkDirectory, error);
+    reportThroughput("Octree chunk build pass", static_cast<size_t>(totalPoints), passTimer.seconds());
+
+    // Pass 5: Fill Nodes Above the Chunks by Pulling Samples Up From Their Children
+    passTimer = Stopwatch();
+    std::set<uint64_t> upper;
+    for (const Chunk& chunk : chunks) 
+    {
+        for (int level = chunk.level - 1; level >= 0; level--) upper.insert(nodeKey(level, chunk.morton >> (3 * (chunk.level - level))));
+    }
+    for (uint64_t key : upper) roots[key];
+
+    int deepestUpper = upper.empty() ? -1 : keyLevel(*upper.rbegin());
+    for (int level = deepestUpper; level >= 0; level--) 
+    {
+        std::vector<uint64_t> keys;
+        for (uint64_t key : upper) if (keyLevel(key) == level) keys.push_back(key);
+
+        parallelTasks(keys.size(), [&](size_t k, unsigned worker) 
+        {
+            uint64_t morton = keyMorton(keys[k]);
+            std::vector<Point>& samples = roots.at(keys[k]);
+            for (int octant = 0; octant < 8; octant++) 
+            {
+                auto child = roots.find(nodeKey(level + 1, morton << 3 | octant));
+                if (child == roots.end()) continue;
+
+                takeSamples(context, level, morton, child->second, samples, occupied[worker]);
+                writeNode(context, child->first, child->second.data(), child->second.size());
+                std::vector<Point>().swap(child->second);
+            }
+        });
+    }
+    std::vector<Point>& top = roots[nodeKey(0, 0)];
+    writeNode(context, nodeKey(0, 0), top.data(), top.size());
+    roots.clear();
+    context.pointsFile.close();
+
+    // Hierarchy: Sorting by (Level, Morton) Keeps Siblings Contiguous in Octant Order
+    std::sort(context.nodes.begin(), context.nodes.end(), [](const BuiltNode& a, const BuiltNode& b) { return a.key < b.key; });
+    std::unordered_map<uint64_t, uint32_t> indexOf;
+    for (size_t i = 0; i < context.nodes.size(); i++) indexOf[context.nodes[i].key] = static_cast<uint32_t>(i);
+
+    std::vector<OctreeNode> nodes(context.nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) 
+    {
+        const BuiltNode& built = context.nodes[i];
+        int level = keyLevel(built.key);
+        uint64_t morton = keyMorton(built.key);
+
+        OctreeNode& node = nodes[i];
+        node = {};
+        node.bounds = nodeBounds(context, level, morton);
+        node.byteOffset = built.byteOffset;
+        node.pointCount = built.pointCount;
+        node.level = static_cast<uint8_t>(level);
+        for (int octant = 7; octant >= 0; octant--) 
+        {
+            auto child = indexOf.find(nodeKey(level + 1, morton << 3 | octant));
+            if (child == indexOf.end()) continue;
+            node.childMask |= 1 << octant;
+            node.firstChild = child->second;
+        }
+    }
+
+    OctreeHeader header = {};
+    header.pointCount = totalPoints;
+    header.cube = context.cube;
+    header.spacing = context.size / settings.sampleGrid;
+    if (!writeOctreeHierarchy(outputDirectory, header, nodes)) return false;
+
+    std::cout << "Octree upper levels: " << upper.size() << " nodes in " << passTimer.seconds() * 1000.0 << " ms" << std::endl;
+    std::cout << "Octree has " << nodes.size() << " nodes" << std::endl;
+    reportThroughput("Built octree", static_cast<size_t>(totalPoints), totalTimer.seconds());
+    std::cout << "Peak memory: " << peakMemoryBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Out-of-Core Octree Build Parameters
+struct OctreeBuildSettings 
+{
+    size_t batchPoints = size_t(1) << 22;     // Points Read From the Input at a Time
+    size_t maxChunkPoints = size_t(1) << 22;  // Largest Subtree Built in Memory by One Thread
+    uint32_t maxNodePoints = 1u << 15;        // Nodes Above This Are Subsampled and Split
+    int sampleGrid = 128;                     // Subsample Cells per Node Axis
+    int countingGridLevels = 7;               // Counting Grid Is 2^levels Cells per Axis
+};
+
+// Convert a Text or LAS File Into a Potree-Style Octree Directory
+bool buildOctree(const std::string& input, const std::string& outputDirectory, const OctreeBuildSettings& settings = {});
@@ -0,0 +1,293 @@
+//sources
+// Schuetz - Potree: Rendering Large Point Clouds in Web Browsers (2016)
+
+#include "OctreeRenderer.h"
+#include "Frustum.h"
+#include "PointRenderer.h"
+
+#include <gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <queue>
+
+namespace 
+{
+    // Reads of One Node Tried Before It Is Left Out of the View
+    const uint8_t maxNodeReads = 3;
+
+    // Read Requested Nodes Until the Renderer Stops
+    void loaderThread(OctreeRenderer& renderer) 
+    {
+        std::ifstream file(octreePointsPath(renderer.directory), std::ios::binary);
+        for (;;) 
+        {
+            uint32_t node;
+            {
+                std::unique_lock<std::mutex> lock(renderer.mutex);
+                renderer.wake.wait(lock, [&]() { return renderer.stopping || !renderer.requests.empty(); });
+                if (renderer.stopping) return;
+                node = renderer.requests.back().node;
+                renderer.requests.pop_back();
+            }
+
+            const OctreeNode& info = renderer.nodes[node];
+            std::vector<Point> points(info.pointCount);
+            file.seekg(static_cast<std::streamoff>(info.byteOffset));
+            file.read(reinterpret_cast<char*>(points.data()), static_cast<std::streamsize>(points.size() * sizeof(Point)));
+            bool failed = !file;
+            if (failed) 
+            {
+                std::cerr << "Failed to read octree node " << node << std::endl;
+                file.clear();
+                points.clear();
+            }
+
+            std::lock_guard<std::mutex> lock(renderer.mutex);
+            renderer.completed.push_back({ node, std::move(points), failed });
+        }
+    }
+
+    float edgeLength(const Bounds& bounds) 
+    {
+        return bounds.maxX - bounds.minX;
+    }
+
+    // Screen Pixels per Model Unit Around a Node
+    float pixelsPerUnit(const glm::mat4& mvp, const Bounds& bounds, int viewportHeight) 
+    {
+        glm::vec4 center((bounds.minX + bounds.maxX) / 2.0f, (bounds.minY + bounds.maxY) / 2.0f, (bounds.minZ + bounds.maxZ) / 2.0f, 1.0f);
+        float w = std::max((mvp * center).w, 1.0e-6f);
+        float rate = glm::length(glm::vec3(mvp[0][1], mvp[1][1], mvp[2][1]));
+        return rate / w * viewportHeight / 2.0f;
+    }
+
+    void touch(std::list<uint32_t>& lru, std::list<uint32_t>::iterator entry) 
+    {
+        lru.splice(lru.begin(), lru, entry);
+    }
+
+    // Walk the Hierarchy Largest-on-Screen First; Ready Nodes Go to visible, Missing Ones to wanted
+    void selectNodes(OctreeRenderer& renderer, const glm::mat4& mvp, int viewportHeight, float priorityScale,
+                     std::vector<uint32_t>* visible, std::vector<OctreeLoadRequest>& wanted) 
+    {
+        if (renderer.nodes.empty()) return;
+        Frustum frustum = extractFrustum(mvp);
+        if (!intersectsFrustum(frustum, renderer.nodes[0].bounds)) return;
+
+        std::priority_queue<std::pair<float, uint32_t>> open;
+        const Bounds& rootBounds = renderer.nodes[0].bounds;
+        open.push({ edgeLength(rootBounds) * pixelsPerUnit(mvp, rootBounds, viewportHeight), 0 });
+        size_t remaining = renderer.settings.pointBudget;
+        while (!open.empty()) 
+        {
+            auto [priority, index] = open.top();
+            open.pop();
+            const OctreeNode& node = renderer.nodes[index];
+            OctreeNodeCache& cache = renderer.cache[index];
+            if (node.pointCount > remaining) break;
+
+            cache.lastUsed = renderer.frame;
+            if (node.pointCount > 0 && !cache.inRam && cache.vbo == 0) 
+            {
+                if (cache.failedReads < maxNodeReads) wanted.push_back({ priority * priorityScale, index });
+                continue;
+            }
+            if (visible) visible->push_back(index);
+            remaining -= node.pointCount;
+
+            float scale = pixelsPerUnit(mvp, node.bounds, viewportHeight);
+            float spacing = renderer.header.spacing / float(1u << node.level);
+            if (spacing * scale <= renderer.settings.maxSpacingPixels) continue;
+
+            for (int octant = 0; octant < 8; octant++) 
+            {
+                int child = octreeChild(renderer.nodes, index, octant);
+                if (child < 0 || !intersectsFrustum(frustum, renderer.nodes[child].bounds)) continue;
+                open.push({ edgeLength(renderer.nodes[child].bounds) * scale, static_cast<uint32_t>(child) });
+            }
+        }
+    }
+
+    // Move Finished Loads Into the RAM Cache
+    void collectLoadedNodes(OctreeRenderer& renderer) 
+    {
+        std::vector<OctreeLoadedNode> loaded;
+        {
+            std::lock_guard<std::mutex> lock(renderer.mutex);
+            loaded.swap(renderer.completed);
+        }
+
+        for (OctreeLoadedNode& item : loaded) 
+        {
+            OctreeNodeCache& cache = renderer.cache[item.node];
+            cache.queued = false;
+
+            // A Failed Read Leaves the Node Unloaded, So the Next Frames Request It Again Until the Attempts Run Out
+            if (item.failed) 
+            {
+                cache.failedReads++;
+                continue;
+            }
+            cache.points = std::move(item.points);
+            cache.inRam = true;
+            renderer.ramBytes += cache.points.size() * sizeof(Point);
+            renderer.ramLru.push_front(item.node);
+            cache.ramEntry = renderer.ramLru.begin();
+        }
+    }
+
+    // Replace the Load Queue With This Frame's Wishes
+    void requestNodes(OctreeRenderer& renderer, std::vector<OctreeLoadRequest>& wanted) 
+    {
+        std::sort(wanted.begin(), wanted.end(), [](const OctreeLoadRequest& a, const OctreeLoadRequest& b) { return a.priority < b.priority; });
+        {
+            std::lock_guard<std::mutex> lock(renderer.mutex);
+            for (const OctreeLoadRequest& request : renderer.requests) renderer.cache[request.node].queued = false;
+            renderer.requests.clear();
+            for (const OctreeLoadRequest& request : wanted) 
+            {
+                OctreeNodeCache& cache = renderer.cache[request.node];
+                if (cache.queued) continue;
+                cache.queued = true;
+                renderer.requests.push_back(request);
+            }
+        }
+        renderer.wake.notify_all();
+    }
+
+    // Drop Least Recently Used Nodes Not Needed This Frame Until Both Caches Fit
+    void evictNodes(OctreeRenderer& renderer) 
+    {
+        for (auto entry = renderer.ramLru.end(); renderer.ramBytes > renderer.settings.ramBudget && entry != renderer.ramLru.begin();) 
+        {
+            OctreeNodeCache& cache = renderer.cache[*--entry];
+            if (cache.lastUsed == renderer.frame) continue;
+            renderer.ramBytes -= cache.points.size() * sizeof(Point);
+            std::vector<Point>().swap(cache.points);
+            cache.inRam = false;
+            entry = renderer.ramLru.erase(entry);
+        }
+
+        for (auto entry = renderer.gpuLru.end(); renderer.gpuBytes > renderer.settings.gpuBudget && entry != renderer.gpuLru.begin();) 
+        {
+            uint32_t index = *--entry;
+            OctreeNodeCache& cache = renderer.cache[index];
+            if (cache.lastUsed == renderer.frame) continue;
+            renderer.gpuBytes -= cache.vboPoints * sizeof(Point);
+            glDeleteBuffers(1, &cache.vbo);
+            cache.vbo = 0;
+            cache.vboPoints = 0;
+            entry = renderer.gpuLru.erase(entry);
+        }
+    }
+}
+
+bool createOctreeRenderer(OctreeRenderer& renderer, const std::string& directory, const OctreeViewSettings& settings) 
+{
+    renderer.settings = settings;
+    renderer.directory = directory;
+    if (!loadOctreeHierarchy(directory, renderer.header, renderer.nodes)) return false;
+    renderer.cache.resize(renderer.nodes.size());
+
+    renderer.program = createPointProgram();
+    if (!renderer.program) return false;
+    renderer.mvpLocation = glGetUniformLocation(renderer.program, "mvp");
+    renderer.model = normalizationMatrix(renderer.header.cube);
+
+    glGenVertexArrays(1, &renderer.vao);
+    glBindVertexArray(renderer.vao);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    for (unsigned i = 0; i < std::max(1u, settings.loaderThreads); i++) 
+    {
+        renderer.loaders.emplace_back(loaderThread, std::ref(renderer));
+    }
+
+    std::cout << "Opened octree with " << renderer.nodes.size() << " nodes and " << renderer.header.pointCount << " points" << std::endl;
+    return true;
+}
+
+void drawOctree(OctreeRenderer& renderer, const glm::mat4& projection, const glm::mat4& view, int viewportHeight) 
+{
+    renderer.frame++;
+    collectLoadedNodes(renderer);
+
+    glm::mat4 mvp = projection * view * renderer.model;
+    std::vector<uint32_t> visible;
+    std::vector<OctreeLoadRequest> wanted;
+    selectNodes(renderer, mvp, viewportHeight, 1.0f, &visible, wanted);
+
+    // Prefetch Along the Camera's Motion by Extrapolating the Matrix Linearly
+    if (renderer.frame > 1 && mvp != renderer.previousMvp) 
+    {
+        glm::mat4 predicted = mvp + (mvp - renderer.previousMvp) * renderer.settings.prefetchFrames;
+        selectNodes(renderer, predicted, viewportHeight, 0.5f, nullptr, wanted);
+    }
+    renderer.previousMvp = mvp;
+    requestNodes(renderer, wanted);
+
+    glUseProgram(renderer.program);
+    glUniformMatrix4fv(renderer.mvpLocation, 1, GL_FALSE, glm::value_ptr(mvp));
+    glBindVertexArray(renderer.vao);
+
+    size_t uploaded = 0;
+    renderer.pointsDrawn = 0;
+    renderer.nodesDrawn = 0;
+    for (uint32_t index : visible) 
+    {
+        const OctreeNode& node = renderer.nodes[index];
+        OctreeNodeCache& cache = renderer.cache[index];
+        if (node.pointCount == 0) continue;
+
+        if (cache.inRam) touch(renderer.ramLru, cache.ramEntry);
+        if (cache.vbo == 0) 
+        {
+            // Upload What Was Actually Read, Which Only a Failed or Short Read Makes Differ From the Node's Count
+            size_t bytes = cache.points.size() * sizeof(Point);
+            if (bytes == 0 || (uploaded + bytes > renderer.settings.uploadBudget && uploaded > 0)) continue;
+            glGenBuffers(1, &cache.vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, cache.vbo);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), cache.points.data(), GL_STATIC_DRAW);
+            cache.vboPoints = cache.points.size();
+            uploaded += bytes;
+            renderer.gpuBytes += bytes;
+            renderer.gpuLru.push_front(index);
+            cache.gpuEntry = renderer.gpuLru.begin();
+        }
+        else 
+        {
+            touch(renderer.gpuLru, cache.gpuEntry);
+            glBindBuffer(GL_ARRAY_BUFFER, cache.vbo);
+        }
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Point), nullptr);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(cache.vboPoints));
+        renderer.pointsDrawn += cache.vboPoints;
+        renderer.nodesDrawn++;
+    }
+    glBindVertexArray(0);
+
+    evictNodes(renderer);
+}
+
+void destroyOctreeRenderer(OctreeRenderer& renderer) 
+{
+    {
+        std::lock_guard<std::mutex> lock(renderer.mutex);
+        renderer.stopping = true;
+    }
+    renderer.wake.notify_all();
+    for (std::thread& loader : renderer.loaders) loader.join();
+    renderer.loaders.clear();
+
+    for (OctreeNodeCache& cache : renderer.cache) 
+    {
+        if (cache.vbo) glDeleteBuffers(1, &cache.vbo);
+    }
+    glDeleteVertexArrays(1, &renderer.vao);
+    glDeleteProgram(renderer.program);
+    renderer.cache.clear();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm.hpp>
+
+#include "Octree.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streaming Limits for the Octree Viewer
+struct OctreeViewSettings 
+{
+    size_t pointBudget = 4000000;                // Points Drawn per Frame
+    size_t ramBudget = size_t(1024) << 20;       // Node Bytes Kept in RAM
+    size_t gpuBudget = size_t(512) << 20;        // Node Bytes Kept in VBOs
+    size_t uploadBudget = size_t(32) << 20;      // Node Bytes Uploaded per Frame
+    float maxSpacingPixels = 1.0f;               // Refine While Point Spacing Projects Wider Than This
+    float prefetchFrames = 15.0f;                // How Far Camera Motion Is Extrapolated for Prefetching
+    unsigned loaderThreads = 2;
+};
+
+// Residency of One Node
+struct OctreeNodeCache 
+{
+    bool queued = false;
+    bool inRam = false;
+    uint8_t failedReads = 0;
+    std::vector<Point> points;
+    GLuint vbo = 0;
+    size_t vboPoints = 0;
+    uint64_t lastUsed = 0;
+    std::list<uint32_t>::iterator ramEntry;
+    std::list<uint32_t>::iterator gpuEntry;
+};
+
+// Node Waiting for a Loader Thread
+struct OctreeLoadRequest 
+{
+    float priority;
+    uint32_t node;
+};
+
+// Node Read by a Loader Thread, Waiting for the Render Thread
+struct OctreeLoadedNode 
+{
+    uint32_t node;
+    std::vector<Point> points;
+    bool failed = false;
+};
+
+// Level-of-Detail Renderer Streaming Nodes From an Octree Directory
+struct OctreeRenderer 
+{
+    OctreeViewSettings settings;
+    std::string directory;
+    OctreeHeader header = {};
+    std::vector<OctreeNode> nodes;
+    std::vector<OctreeNodeCache> cache;
+
+    // Least Recently Used at the Back
+    std::list<uint32_t> ramLru;
+    std::list<uint32_t> gpuLru;
+    size_t ramBytes = 0;
+    size_t gpuBytes = 0;
+
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLint mvpLocation = -1;
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::mat4 previousMvp = glm::mat4(0.0f);
+    uint64_t frame = 0;
+
+    // Shared With Loader Threads
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<OctreeLoadRequest> requests;
+    std::vector<OctreeLoadedNode> completed;
+    bool stopping = false;
+    std::vector<std::thread> loaders;
+
+    // Last Frame's Statistics
+    size_t pointsDrawn = 0;
+    size_t nodesDrawn = 0;
+};
+
+// Load the Hierarchy and Start Loader Threads
+bool createOctreeRenderer(OctreeRenderer& renderer, const std::string& directory, const OctreeViewSettings& settings = {});
+
+// Select, Stream and Draw Nodes for the Current Camera
+void drawOctree(OctreeRenderer& renderer, const glm::mat4& projection, const glm::mat4& view, int viewportHeight);
+
+// Stop Loaders and Release GL Objects
+void destroyOctreeRenderer(OctreeRenderer& renderer);
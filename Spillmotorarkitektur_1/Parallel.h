@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Number of Worker Threads
+inline unsigned workerCount() 
+{
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+// Run fn(begin, end, worker) Over Contiguous Slices of [0, count)
+template <typename Fn>
+void parallelFor(size_t count, Fn&& fn) 
+{
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(workerCount(), std::max<size_t>(count, 1)));
+    if (workers <= 1) 
+    {
+        fn(size_t(0), count, 0u);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    size_t slice = (count + workers - 1) / workers;
+    for (unsigned w = 1; w < workers; w++) 
+    {
+        size_t begin = std::min(count, w * slice);
+        size_t end = std::min(count, begin + slice);
+        threads.emplace_back([&fn, begin, end, w]() { fn(begin, end, w); });
+    }
+    fn(size_t(0), std::min(count, slice), 0u);
+    for (auto& thread : threads) 
+    {
+        thread.join();
+    }
+}
+
+// Run fn(task, worker) For Every Task, Handing Tasks Out Dynamically
+template <typename Fn>
+void parallelTasks(size_t taskCount, Fn&& fn) 
+{
+    std::atomic<size_t> next{ 0 };
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(workerCount(), std::max<size_t>(taskCount, 1)));
+    auto run = [&](unsigned worker) 
+    {
+        for (size_t task = next++; task < taskCount; task = next++) 
+        {
+            fn(task, worker);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; w++) 
+    {
+        threads.emplace_back(run, w);
+    }
+    run(0);
+    for (auto& thread : threads) 
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+// Store XYZ Coordinates
+struct Point 
+{
+    float x, y, z;
+};
+
+// Axis-Aligned Bounding Box
+struct Bounds 
+{
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+};
+
+// Bounds That Contain Nothing Yet
+inline Bounds emptyBounds() 
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    return { inf, inf, inf, -inf, -inf, -inf };
+}
+
+// Grow Bounds to Include a Point
+inline void includePoint(Bounds& bounds, const Point& p) 
+{
+    bounds.minX = std::min(bounds.minX, p.x);
+    bounds.minY = std::min(bounds.minY, p.y);
+    bounds.minZ = std::min(bounds.minZ, p.z);
+    bounds.maxX = std::max(bounds.maxX, p.x);
+    bounds.maxY = std::max(bounds.maxY, p.y);
+    bounds.maxZ = std::max(bounds.maxZ, p.z);
+}
+
+// Grow Bounds to Include Other Bounds
+inline void includeBounds(Bounds& bounds, const Bounds& other) 
+{
+    bounds.minX = std::min(bounds.minX, other.minX);
+    bounds.minY = std::min(bounds.minY, other.minY);
+    bounds.minZ = std::min(bounds.minZ, other.minZ);
+    bounds.maxX = std::max(bounds.maxX, other.maxX);
+    bounds.maxY = std::max(bounds.maxY, other.maxY);
+    bounds.maxZ = std::max(bounds.maxZ, other.maxZ);
+}
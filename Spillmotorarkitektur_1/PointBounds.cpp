@@ -0,0 +1,46 @@
+#include "PointBounds.h"
+#include "Simd.h"
+
+Bounds computeBounds(const Point* points, size_t count) 
+{
+    Bounds bounds = emptyBounds();
+    size_t i = 0;
+
+#ifdef SIMD_SSE2
+    // Four Packed Points Fill Three Registers as x y z x | y z x y | z x y z
+    if (count >= 4) 
+    {
+        const float* data = &points[0].x;
+        __m128 min0 = _mm_loadu_ps(data), min1 = _mm_loadu_ps(data + 4), min2 = _mm_loadu_ps(data + 8);
+        __m128 max0 = min0, max1 = min1, max2 = min2;
+        for (i = 4; i + 4 <= count; i += 4) 
+        {
+            const float* p = data + i * 3;
+            __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+            min0 = _mm_min_ps(min0, a);
+            min1 = _mm_min_ps(min1, b);
+            min2 = _mm_min_ps(min2, c);
+            max0 = _mm_max_ps(max0, a);
+            max1 = _mm_max_ps(max1, b);
+            max2 = _mm_max_ps(max2, c);
+        }
+
+        // Lane j Holds Axis j % 3
+        float lo[12], hi[12];
+        _mm_storeu_ps(lo, min0);
+        _mm_storeu_ps(lo + 4, min1);
+        _mm_storeu_ps(lo + 8, min2);
+        _mm_storeu_ps(hi, max0);
+        _mm_storeu_ps(hi + 4, max1);
+        _mm_storeu_ps(hi + 8, max2);
+        for (int lane = 0; lane < 12; lane += 3) 
+        {
+            includePoint(bounds, { lo[lane], lo[lane + 1], lo[lane + 2] });
+            includePoint(bounds, { hi[lane], hi[lane + 1], hi[lane + 2] });
+        }
+    }
+#endif
+
+    for (; i < count; i++) includePoint(bounds, points[i]);
+    return bounds;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+
+// Points Handled per Bounds Update While Parsing, Small Enough to Still Be in L1
+const size_t boundsBlockPoints = 1024;
+
+// Vectorized Bounds of a Packed Point Array
+Bounds computeBounds(const Point* points, size_t count);
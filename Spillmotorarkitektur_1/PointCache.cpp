@@ -0,0 +1,130 @@
+#include "PointCache.h"
+#include "Profiling.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace 
+{
+    const char cacheMagic[8] = { 'V', 'O', 'S', 'P', 'T', 'C', '\0', '\0' };
+    const uint32_t cacheVersion = 3;
+    const uint32_t cacheMortonSorted = 1;
+
+    // Cache File Header, Followed by Raw Source Points at dataOffset
+    struct PointCacheHeader 
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t pointSize;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t pointCount;
+        uint64_t dataOffset;
+        Bounds bounds;
+        uint32_t flags;
+    };
+
+    const uint64_t cacheDataOffset = (sizeof(PointCacheHeader) + 63) & ~uint64_t(63);
+
+    bool sourceStamp(const std::string& sourceFile, uint64_t& size, int64_t& time) 
+    {
+        std::error_code error;
+        size = std::filesystem::file_size(sourceFile, error);
+        if (error) return false;
+        time = static_cast<int64_t>(std::filesystem::last_write_time(sourceFile, error).time_since_epoch().count());
+        return !error;
+    }
+}
+
+std::string pointCachePath(const std::string& sourceFile) 
+{
+    return sourceFile + ".ptc";
+}
+
+bool loadPointCache(const std::string& sourceFile, PointCloud& cloud) 
+{
+    Stopwatch timer;
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (!sourceStamp(sourceFile, sourceSize, sourceTime)) return false;
+
+    MappedFile file;
+    if (!file.open(pointCachePath(sourceFile))) return false;
+    if (file.size() < sizeof(PointCacheHeader)) return false;
+
+    PointCacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 || header.version != cacheVersion ||
+        header.pointSize != sizeof(Point)) 
+    {
+        return false;
+    }
+
+    if (header.sourceSize != sourceSize || header.sourceTime != sourceTime) 
+    {
+        std::cout << "Point cache is stale, reparsing " << sourceFile << std::endl;
+        return false;
+    }
+
+    if (header.dataOffset % alignof(Point) != 0 || file.size() != header.dataOffset + header.pointCount * sizeof(Point)) 
+    {
+        std::cerr << "Point cache is truncated: " << pointCachePath(sourceFile) << std::endl;
+        return false;
+    }
+
+    cloud.adopt(std::move(file), static_cast<size_t>(header.dataOffset), static_cast<size_t>(header.pointCount), header.bounds);
+    cloud.mortonSorted = (header.flags & cacheMortonSorted) != 0;
+    reportThroughput("Mapped point cache", cloud.count, timer.seconds());
+    return true;
+}
+
+bool writePointCache(const std::string& sourceFile, const PointCloud& cloud) 
+{
+    PointCacheHeader header = {};
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+    header.pointSize = sizeof(Point);
+    header.pointCount = cloud.count;
+    header.dataOffset = cacheDataOffset;
+    header.bounds = cloud.bounds;
+    header.flags = cloud.mortonSorted ? cacheMortonSorted : 0;
+    if (!sourceStamp(sourceFile, header.sourceSize, header.sourceTime)) return false;
+
+    // Write Beside the Final Name and Rename So Readers Never See a Partial File
+    std::string path = pointCachePath(sourceFile);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) 
+        {
+            std::cerr << "Failed to write point cache: " << path << std::endl;
+            return false;
+        }
+
+        char padding[cacheDataOffset] = {};
+        std::memcpy(padding, &header, sizeof(header));
+        file.write(padding, sizeof(padding));
+        file.write(reinterpret_cast<const char*>(cloud.points), static_cast<std::streamsize>(cloud.count * sizeof(Point)));
+        if (!file) 
+        {
+            std::cerr << "Failed to write point cache: " << path << std::endl;
+            file.close();
+            std::filesystem::remove(tempPath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) 
+    {
+        std::cerr << "Failed to write point cache: " << path << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
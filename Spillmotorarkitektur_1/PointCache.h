@@ -0,0 +1,14 @@
+#pragma once
+
+#include "PointCloud.h"
+
+#include <string>
+
+// Sidecar Cache File Next to the Source Data
+std::string pointCachePath(const std::string& sourceFile);
+
+// Map Cached Points if the Cache Matches the Source File's Size and Time
+bool loadPointCache(const std::string& sourceFile, PointCloud& cloud);
+
+// Write Raw Points and Their Bounds to the Sidecar Cache
+bool writePointCache(const std::string& sourceFile, const PointCloud& cloud);
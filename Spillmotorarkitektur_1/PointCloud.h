@@ -0,0 +1,43 @@
+#pragma once
+
+#include "LasReader.h"
+#include "MappedFile.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Raw Points Owned in Memory or Viewed Straight From a Mapped File, Never Modified After Loading
+struct PointCloud 
+{
+    std::vector<Point> storage;
+    MappedFile mapping;
+    const Point* points = nullptr;
+    size_t count = 0;
+    Bounds bounds = {};
+    PointAttributes attributes;
+    bool mortonSorted = false;
+
+    void adopt(std::vector<Point>&& owned, const Bounds& pointBounds) 
+    {
+        mapping.close();
+        storage = std::move(owned);
+        points = storage.data();
+        count = storage.size();
+        bounds = pointBounds;
+        mortonSorted = false;
+    }
+
+    void adopt(MappedFile&& file, size_t offset, size_t pointCount, const Bounds& pointBounds) 
+    {
+        storage = std::vector<Point>();
+        mapping = std::move(file);
+        points = reinterpret_cast<const Point*>(mapping.data() + offset);
+        count = pointCount;
+        bounds = pointBounds;
+        mortonSorted = false;
+    }
+
+    bool empty() const { return count == 0; }
+};
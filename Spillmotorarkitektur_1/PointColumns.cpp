@@ -0,0 +1,234 @@
+#include "PointColumns.h"
+#include "Parallel.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace 
+{
+    // Values Summed in Float Lanes Before Folding Into Doubles
+    const size_t sumBlock = 4096;
+
+    HeightStats finishStats(size_t count, float minimum, float maximum, float shift, double sum, double squares) 
+    {
+        HeightStats stats;
+        if (count == 0) return stats;
+        stats.count = count;
+        stats.minimum = minimum;
+        stats.maximum = maximum;
+        double mean = sum / count;
+        stats.mean = shift + mean;
+        stats.deviation = std::sqrt(std::max(0.0, squares / count - mean * mean));
+        return stats;
+    }
+}
+
+void buildColumns(const Point* points, size_t count, const PointAttributes& attributes, PointColumns& columns) 
+{
+    columns.x.resize(count);
+    columns.y.resize(count);
+    columns.z.resize(count);
+    columns.intensity.assign(count, 0);
+    columns.classification.assign(count, 0);
+    columns.returnNumber.assign(count, 0);
+
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            columns.x[i] = points[i].x;
+            columns.y[i] = points[i].y;
+            columns.z[i] = points[i].z;
+        }
+    });
+
+    size_t intensityCount = std::min(count, attributes.intensity.size());
+    size_t classCount = std::min(count, attributes.classification.size());
+    size_t returnCount = std::min(count, attributes.returnNumber.size());
+    std::copy(attributes.intensity.begin(), attributes.intensity.begin() + intensityCount, columns.intensity.begin());
+    std::copy(attributes.classification.begin(), attributes.classification.begin() + classCount, columns.classification.begin());
+    std::copy(attributes.returnNumber.begin(), attributes.returnNumber.begin() + returnCount, columns.returnNumber.begin());
+}
+
+ColumnRange columnRange(const float* values, size_t count) 
+{
+    ColumnRange range = { INFINITY, -INFINITY };
+    size_t i = 0;
+
+#ifdef SIMD_SSE2
+    if (count >= 8) 
+    {
+        __m128 min0 = _mm_loadu_ps(values), min1 = _mm_loadu_ps(values + 4);
+        __m128 max0 = min0, max1 = min1;
+        for (i = 8; i + 8 <= count; i += 8) 
+        {
+            __m128 a = _mm_loadu_ps(values + i), b = _mm_loadu_ps(values + i + 4);
+            min0 = _mm_min_ps(min0, a);
+            min1 = _mm_min_ps(min1, b);
+            max0 = _mm_max_ps(max0, a);
+            max1 = _mm_max_ps(max1, b);
+        }
+
+        float lo[4], hi[4];
+        _mm_storeu_ps(lo, _mm_min_ps(min0, min1));
+        _mm_storeu_ps(hi, _mm_max_ps(max0, max1));
+        range.minimum = std::min({ lo[0], lo[1], lo[2], lo[3] });
+        range.maximum = std::max({ hi[0], hi[1], hi[2], hi[3] });
+    }
+#endif
+
+    for (; i < count; i++) 
+    {
+        range.minimum = std::min(range.minimum, values[i]);
+        range.maximum = std::max(range.maximum, values[i]);
+    }
+    return range;
+}
+
+Bounds columnBounds(const PointColumns& columns) 
+{
+    const float* axes[3] = { columns.x.data(), columns.y.data(), columns.z.data() };
+    ColumnRange ranges[3];
+    parallelTasks(3, [&](size_t axis, unsigned) 
+    {
+        ranges[axis] = columnRange(axes[axis], columns.size());
+    });
+    return { ranges[0].minimum, ranges[1].minimum, ranges[2].minimum, ranges[0].maximum, ranges[1].maximum, ranges[2].maximum };
+}
+
+size_t selectEqual(const uint8_t* values, size_t count, uint8_t value, uint32_t* out) 
+{
+    size_t selected = 0;
+    size_t i = 0;
+
+#ifdef SIMD_SSE2
+    // Sixteen Entries per Compare, Runs of Misses Cost One Branch
+    __m128i target = _mm_set1_epi8(static_cast<char>(value));
+    for (; i + 16 <= count; i += 16) 
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+        while (mask) 
+        {
+            out[selected++] = static_cast<uint32_t>(i + lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) 
+    {
+        if (values[i] == value) out[selected++] = static_cast<uint32_t>(i);
+    }
+    return selected;
+}
+
+size_t selectRange(const float* values, size_t count, float minimum, float maximum, uint32_t* out) 
+{
+    size_t selected = 0;
+    size_t i = 0;
+
+#ifdef SIMD_SSE2
+    __m128 lo = _mm_set1_ps(minimum), hi = _mm_set1_ps(maximum);
+    for (; i + 4 <= count; i += 4) 
+    {
+        __m128 block = _mm_loadu_ps(values + i);
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(block, lo), _mm_cmple_ps(block, hi))));
+        while (mask) 
+        {
+            out[selected++] = static_cast<uint32_t>(i + lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) 
+    {
+        if (values[i] >= minimum && values[i] <= maximum) out[selected++] = static_cast<uint32_t>(i);
+    }
+    return selected;
+}
+
+HeightStats heightStats(const float* values, size_t count) 
+{
+    if (count == 0) return HeightStats();
+
+    // Sum Offsets From the First Value So Float Lanes Keep Their Precision
+    ColumnRange range = columnRange(values, count);
+    float shift = values[0];
+    double sum = 0.0, squares = 0.0;
+    for (size_t first = 0; first < count; first += sumBlock) 
+    {
+        size_t last = std::min(count, first + sumBlock);
+        size_t i = first;
+        float blockSum = 0.0f, blockSquares = 0.0f;
+
+#ifdef SIMD_SSE2
+        __m128 origin = _mm_set1_ps(shift);
+        __m128 sums = _mm_setzero_ps(), squareSums = _mm_setzero_ps();
+        for (; i + 4 <= last; i += 4) 
+        {
+            __m128 d = _mm_sub_ps(_mm_loadu_ps(values + i), origin);
+            sums = _mm_add_ps(sums, d);
+            squareSums = _mm_add_ps(squareSums, _mm_mul_ps(d, d));
+        }
+        float lanes[4], squareLanes[4];
+        _mm_storeu_ps(lanes, sums);
+        _mm_storeu_ps(squareLanes, squareSums);
+        blockSum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        blockSquares = squareLanes[0] + squareLanes[1] + squareLanes[2] + squareLanes[3];
+#endif
+
+        for (; i < last; i++) 
+        {
+            float d = values[i] - shift;
+            blockSum += d;
+            blockSquares += d * d;
+        }
+        sum += blockSum;
+        squares += blockSquares;
+    }
+    return finishStats(count, range.minimum, range.maximum, shift, sum, squares);
+}
+
+HeightStats heightStats(const float* values, const uint32_t* indices, size_t count) 
+{
+    if (count == 0) return HeightStats();
+
+    float minimum = INFINITY, maximum = -INFINITY;
+    float shift = values[indices[0]];
+    double sum = 0.0, squares = 0.0;
+    for (size_t i = 0; i < count; i++) 
+    {
+        float value = values[indices[i]];
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+        double d = value - shift;
+        sum += d;
+        squares += d * d;
+    }
+    return finishStats(count, minimum, maximum, shift, sum, squares);
+}
+
+void buildClassIndex(const uint8_t* classification, size_t count, ClassIndex& index) 
+{
+    // Histogram to Place Each Class, Then One Vectorized Select per Class Present
+    size_t histogram[ClassIndex::classCount] = {};
+    for (size_t i = 0; i < count; i++) histogram[classification[i] & 0x1F]++;
+
+    index.start[0] = 0;
+    for (int c = 0; c < ClassIndex::classCount; c++) index.start[c + 1] = index.start[c] + histogram[c];
+    index.indices.resize(count);
+
+    std::vector<int> present;
+    for (int c = 0; c < ClassIndex::classCount; c++) 
+    {
+        if (histogram[c] > 0) present.push_back(c);
+    }
+    parallelTasks(present.size(), [&](size_t task, unsigned) 
+    {
+        int c = present[task];
+        selectEqual(classification, count, static_cast<uint8_t>(c), index.indices.data() + index.start[c]);
+    });
+}
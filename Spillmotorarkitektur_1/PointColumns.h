@@ -0,0 +1,101 @@
+#pragma once
+
+#include "LasReader.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Column Start Alignment, One Cache Line
+const size_t columnAlignment = 64;
+
+// Allocator Returning Cache-Line Aligned Storage
+template <typename T>
+struct AlignedAllocator 
+{
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t count) 
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(columnAlignment)));
+    }
+
+    void deallocate(T* pointer, size_t) 
+    {
+        ::operator delete(pointer, std::align_val_t(columnAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+// One Contiguous Attribute Array
+template <typename T>
+using Column = std::vector<T, AlignedAllocator<T>>;
+
+// Structure-of-Arrays Point Storage, Every Column Has size() Entries
+struct PointColumns 
+{
+    Column<float> x, y, z;
+    Column<uint16_t> intensity;
+    Column<uint8_t> classification;
+    Column<uint8_t> returnNumber;
+
+    size_t size() const { return x.size(); }
+};
+
+// Smallest and Largest Value of a Column
+struct ColumnRange 
+{
+    float minimum, maximum;
+};
+
+// Summary of a Height Column
+struct HeightStats 
+{
+    size_t count = 0;
+    float minimum = 0.0f;
+    float maximum = 0.0f;
+    double mean = 0.0;
+    double deviation = 0.0;
+};
+
+// Point Indices Grouped by Classification, Class c Occupies [start[c], start[c + 1])
+struct ClassIndex 
+{
+    static const int classCount = 32;
+    std::vector<uint32_t> indices;
+    size_t start[classCount + 1] = {};
+};
+
+// Split Packed Points Into Columns, Attributes Missing From attributes Are Zero
+void buildColumns(const Point* points, size_t count, const PointAttributes& attributes, PointColumns& columns);
+
+// Vectorized Min and Max of One Column
+ColumnRange columnRange(const float* values, size_t count);
+
+// Bounds From the Three Coordinate Columns
+Bounds columnBounds(const PointColumns& columns);
+
+// Write Indices of Entries Equal to value, Returns How Many; out Needs Room for count
+size_t selectEqual(const uint8_t* values, size_t count, uint8_t value, uint32_t* out);
+
+// Write Indices of Entries in [minimum, maximum], Returns How Many; out Needs Room for count
+size_t selectRange(const float* values, size_t count, float minimum, float maximum, uint32_t* out);
+
+// Height Summary Over a Whole Column
+HeightStats heightStats(const float* values, size_t count);
+
+// Height Summary Over Selected Entries of a Column
+HeightStats heightStats(const float* values, const uint32_t* indices, size_t count);
+
+// Group Point Indices by Classification Once, So Filters Never Touch the Points Again; Classes Must Be Below 32
+void buildClassIndex(const uint8_t* classification, size_t count, ClassIndex& index);
@@ -0,0 +1,223 @@
+#include "PointRenderer.h"
+#include "PointBounds.h"
+#include "Shader.h"
+
+#include <gtc/matrix_transform.hpp>
+#include <gtc/type_ptr.hpp>
+
+#include <algorithm>
+
+namespace 
+{
+    const char* pointVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+uniform mat4 mvp;
+void main()
+{
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+    // Positions Arrive as [0, 1] Fractions of the Tile
+    const char* quantizedVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+uniform mat4 mvp;
+uniform vec3 tileMin;
+uniform vec3 tileExtent;
+void main()
+{
+    gl_Position = mvp * vec4(tileMin + position * tileExtent, 1.0);
+}
+)";
+
+    const char* pointFragmentShader = R"(#version 330 core
+out vec4 color;
+void main()
+{
+    color = vec4(1.0, 1.0, 1.0, 1.0);
+}
+)";
+
+    // Points per Tile When the Caller Has No Bounds of Its Own
+    const size_t quantizedTilePoints = 65536;
+
+    size_t vertexSize(const PointRenderer& renderer) 
+    {
+        return renderer.quantized ? sizeof(QuantizedPoint) : sizeof(Point);
+    }
+
+    void appendTile(PointRenderer& renderer, const Point* points, size_t count, const Bounds& bounds) 
+    {
+        renderer.scratch.resize(count);
+        float error = quantizePoints(points, count, bounds, renderer.scratch.data());
+        renderer.maxError = std::max(renderer.maxError, error);
+        renderer.errorBound = std::max(renderer.errorBound, quantizationErrorBound(bounds));
+
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(renderer.count) * sizeof(QuantizedPoint),
+                        static_cast<GLsizeiptr>(count * sizeof(QuantizedPoint)), renderer.scratch.data());
+        renderer.tiles.push_back({ bounds, static_cast<size_t>(renderer.count), count });
+        renderer.count += static_cast<GLsizei>(count);
+    }
+
+    void drawIndexRange(size_t begin, size_t end) 
+    {
+        if (end <= begin) return;
+        glDrawElements(GL_POINTS, static_cast<GLsizei>(end - begin), GL_UNSIGNED_INT,
+                       reinterpret_cast<const void*>(begin * sizeof(uint32_t)));
+    }
+
+    void setTileUniforms(const PointRenderer& renderer, const QuantizedTile& tile) 
+    {
+        const Bounds& b = tile.bounds;
+        glUniform3f(renderer.tileMinLocation, b.minX, b.minY, b.minZ);
+        glUniform3f(renderer.tileExtentLocation, b.maxX - b.minX, b.maxY - b.minY, b.maxZ - b.minZ);
+    }
+}
+
+GLuint createPointProgram() 
+{
+    return createShaderProgram(pointVertexShader, pointFragmentShader);
+}
+
+GLuint createQuantizedPointProgram() 
+{
+    return createShaderProgram(quantizedVertexShader, pointFragmentShader);
+}
+
+glm::mat4 normalizationMatrix(const Bounds& bounds) 
+{
+    glm::vec3 center((bounds.minX + bounds.maxX) / 2.0f, (bounds.minY + bounds.maxY) / 2.0f, (bounds.minZ + bounds.maxZ) / 2.0f);
+    float scale = std::max({ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY, bounds.maxZ - bounds.minZ }) / 2.0f;
+    if (scale == 0.0f) scale = 1.0f;
+    return glm::translate(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / scale)), -center);
+}
+
+bool createPointRenderer(PointRenderer& renderer, const Point* points, size_t count, bool quantized) 
+{
+    if (!reservePointRenderer(renderer, count, quantized)) return false;
+    appendPoints(renderer, points, count);
+    return true;
+}
+
+bool reservePointRenderer(PointRenderer& renderer, size_t capacity, bool quantized) 
+{
+    renderer.quantized = quantized;
+    renderer.program = quantized ? createQuantizedPointProgram() : createPointProgram();
+    if (!renderer.program) return false;
+    renderer.mvpLocation = glGetUniformLocation(renderer.program, "mvp");
+    renderer.tileMinLocation = glGetUniformLocation(renderer.program, "tileMin");
+    renderer.tileExtentLocation = glGetUniformLocation(renderer.program, "tileExtent");
+
+    glGenVertexArrays(1, &renderer.vao);
+    glGenBuffers(1, &renderer.vbo);
+    glBindVertexArray(renderer.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * vertexSize(renderer)), nullptr, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    if (quantized) glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedPoint), nullptr);
+    else glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Point), nullptr);
+    glBindVertexArray(0);
+    return true;
+}
+
+void appendPoints(PointRenderer& renderer, const Point* points, size_t count, const Bounds* bounds) 
+{
+    if (count == 0) return;
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
+    if (!renderer.quantized) 
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(renderer.count) * sizeof(Point),
+                        static_cast<GLsizeiptr>(count * sizeof(Point)), points);
+        renderer.count += static_cast<GLsizei>(count);
+        return;
+    }
+
+    if (bounds) 
+    {
+        appendTile(renderer, points, count, *bounds);
+        return;
+    }
+    for (size_t first = 0; first < count; first += quantizedTilePoints) 
+    {
+        size_t tileCount = std::min(quantizedTilePoints, count - first);
+        appendTile(renderer, points + first, tileCount, computeBounds(points + first, tileCount));
+    }
+}
+
+void setClassIndex(PointRenderer& renderer, const ClassIndex& index) 
+{
+    glBindVertexArray(renderer.vao);
+    if (!renderer.ebo) glGenBuffers(1, &renderer.ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(index.indices.size() * sizeof(uint32_t)),
+                 index.indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+    std::copy(index.start, index.start + ClassIndex::classCount + 1, renderer.classStart);
+
+    // Indices Ascend Within a Class, So Each Tile Owns One Contiguous Run of Every Class
+    size_t tileCount = renderer.tiles.size();
+    renderer.tileClassStart.assign(ClassIndex::classCount * (tileCount + 1), 0);
+    for (int c = 0; c < ClassIndex::classCount; c++) 
+    {
+        const uint32_t* begin = index.indices.data() + index.start[c];
+        const uint32_t* end = index.indices.data() + index.start[c + 1];
+        size_t* starts = renderer.tileClassStart.data() + c * (tileCount + 1);
+        for (size_t t = 0; t < tileCount; t++) 
+        {
+            starts[t] = std::lower_bound(begin, end, static_cast<uint32_t>(renderer.tiles[t].first)) - index.indices.data();
+        }
+        starts[tileCount] = index.start[c + 1];
+    }
+}
+
+void drawPoints(const PointRenderer& renderer, const glm::mat4& mvp) 
+{
+    glUseProgram(renderer.program);
+    glUniformMatrix4fv(renderer.mvpLocation, 1, GL_FALSE, glm::value_ptr(mvp));
+    glBindVertexArray(renderer.vao);
+    bool filtered = renderer.ebo && renderer.visibleClasses != allClasses;
+
+    if (!renderer.quantized && !filtered) glDrawArrays(GL_POINTS, 0, renderer.count);
+
+    // Adjacent Visible Classes Merge Into One Draw
+    if (!renderer.quantized && filtered) 
+    {
+        size_t runStart = 0;
+        bool inRun = false;
+        for (int c = 0; c <= ClassIndex::classCount; c++) 
+        {
+            bool visible = c < ClassIndex::classCount && (renderer.visibleClasses >> c & 1u);
+            if (visible && !inRun) runStart = renderer.classStart[c];
+            if (!visible && inRun) drawIndexRange(runStart, renderer.classStart[c]);
+            inRun = visible;
+        }
+    }
+
+    size_t tileCount = renderer.tiles.size();
+    for (size_t t = 0; t < tileCount; t++) 
+    {
+        const QuantizedTile& tile = renderer.tiles[t];
+        setTileUniforms(renderer, tile);
+        if (!filtered) 
+        {
+            glDrawArrays(GL_POINTS, static_cast<GLint>(tile.first), static_cast<GLsizei>(tile.count));
+            continue;
+        }
+        for (int c = 0; c < ClassIndex::classCount; c++) 
+        {
+            if (!(renderer.visibleClasses >> c & 1u)) continue;
+            const size_t* starts = renderer.tileClassStart.data() + c * (tileCount + 1);
+            drawIndexRange(starts[t], starts[t + 1]);
+        }
+    }
+    glBindVertexArray(0);
+}
+
+void destroyPointRenderer(PointRenderer& renderer) 
+{
+    glDeleteBuffers(1, &renderer.ebo);
+    glDeleteBuffers(1, &renderer.vbo);
+    glDeleteVertexArrays(1, &renderer.vao);
+    glDeleteProgram(renderer.program);
+    renderer = PointRenderer();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm.hpp>
+
+#include "Point.h"
+#include "PointColumns.h"
+#include "QuantizedPoints.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Class Mask Drawing Every Point
+const uint32_t allClasses = 0xFFFFFFFFu;
+
+// Point Cloud Uploaded Once Into a Vertex Buffer, Optionally as 16-Bit Positions per Tile
+struct PointRenderer 
+{
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLint mvpLocation = -1;
+    GLsizei count = 0;
+
+    bool quantized = false;
+    GLint tileMinLocation = -1;
+    GLint tileExtentLocation = -1;
+    std::vector<QuantizedTile> tiles;
+    std::vector<QuantizedPoint> scratch;
+    float maxError = 0.0f;
+    float errorBound = 0.0f;
+
+    GLuint ebo = 0;
+    uint32_t visibleClasses = allClasses;
+    size_t classStart[ClassIndex::classCount + 1] = {};
+    std::vector<size_t> tileClassStart;
+};
+
+// Compile the Shared Point Shader, Uniform "mvp", Attribute 0 Position
+GLuint createPointProgram();
+
+// Compile the Quantized Point Shader, Uniforms "mvp", "tileMin", "tileExtent", Attribute 0 Normalized Position
+GLuint createQuantizedPointProgram();
+
+// Model Matrix That Centers Bounds and Scales Them Into [-1, 1]
+glm::mat4 normalizationMatrix(const Bounds& bounds);
+
+// Compile the Point Shader and Upload Points
+bool createPointRenderer(PointRenderer& renderer, const Point* points, size_t count, bool quantized = false);
+
+// Compile the Point Shader and Allocate an Empty Buffer for capacity Points
+bool reservePointRenderer(PointRenderer& renderer, size_t capacity, bool quantized = false);
+
+// Copy More Points Behind Those Already Uploaded; When Quantized, Known bounds Make the Range One Tile
+void appendPoints(PointRenderer& renderer, const Point* points, size_t count, const Bounds* bounds = nullptr);
+
+// Upload Indices Grouped by Class so visibleClasses Can Hide Classes Without Touching the Points
+void setClassIndex(PointRenderer& renderer, const ClassIndex& index);
+
+// Draw All Points in One Call, or One Call per Tile When Quantized; Only visibleClasses Once an Index Is Set
+void drawPoints(const PointRenderer& renderer, const glm::mat4& mvp);
+
+// Release GL Objects
+void destroyPointRenderer(PointRenderer& renderer);
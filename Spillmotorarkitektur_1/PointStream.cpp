@@ -0,0 +1,126 @@
+#include "PointStream.h"
+#include "Parallel.h"
+#include "TerrainLoader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace 
+{
+    // Text Bytes Read per Requested Point
+    const size_t textBytesPerPoint = 32;
+
+    // Largest LAS Public Header
+    const size_t lasHeaderBytes = 375;
+}
+
+bool openPointStream(const std::string& filename, PointStream& stream, size_t batchPoints) 
+{
+    stream.file.open(filename, std::ios::binary);
+    if (!stream.file.is_open()) 
+    {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    stream.filename = filename;
+    stream.batchPoints = std::max<size_t>(batchPoints, 1);
+    stream.las = isLasFile(filename);
+    if (stream.las) 
+    {
+        stream.file.seekg(0, std::ios::end);
+        uint64_t fileSize = static_cast<uint64_t>(stream.file.tellg());
+        stream.file.seekg(0);
+
+        char header[lasHeaderBytes] = {};
+        stream.file.read(header, std::min<uint64_t>(fileSize, lasHeaderBytes));
+        if (!readLasHeader(header, static_cast<size_t>(fileSize), stream.header)) return false;
+        stream.dataStart = stream.header.pointOffset;
+    }
+    else 
+    {
+        // Skip the Point Count Header Line
+        char head[256];
+        stream.file.read(head, sizeof(head));
+        size_t numPoints = 0;
+        stream.dataStart = parseTextHeader(head, head + stream.file.gcount(), numPoints) - head;
+    }
+    return rewindPointStream(stream);
+}
+
+bool rewindPointStream(PointStream& stream) 
+{
+    stream.file.clear();
+    stream.file.seekg(static_cast<std::streamoff>(stream.dataStart));
+    stream.carry = 0;
+    stream.nextRecord = 0;
+    return static_cast<bool>(stream.file);
+}
+
+size_t readPointBatch(PointStream& stream, std::vector<Point>& batch) 
+{
+    if (stream.las) 
+    {
+        const LasHeader& header = stream.header;
+        size_t count = static_cast<size_t>(std::min<uint64_t>(stream.batchPoints, header.pointCount - stream.nextRecord));
+        batch.resize(count);
+        if (count == 0) return 0;
+
+        stream.buffer.resize(count * header.recordLength);
+        stream.file.read(stream.buffer.data(), static_cast<std::streamsize>(stream.buffer.size()));
+        if (static_cast<size_t>(stream.file.gcount()) != stream.buffer.size()) 
+        {
+            std::cerr << "LAS file is truncated: " << stream.filename << std::endl;
+            batch.clear();
+            return 0;
+        }
+        stream.nextRecord += count;
+
+        const size_t blockSize = 1 << 16;
+        parallelTasks((count + blockSize - 1) / blockSize, [&](size_t block, unsigned) 
+        {
+            size_t first = block * blockSize;
+            decodeLasPoints(stream.buffer.data() + first * header.recordLength, header, std::min(blockSize, count - first),
+                            batch.data() + first, nullptr, nullptr, nullptr);
+        });
+        return count;
+    }
+
+    // Text: Keep the Partial Last Line for the Next Read
+    stream.buffer.resize(std::max(stream.batchPoints * textBytesPerPoint, stream.carry + 4096));
+    for (;;) 
+    {
+        stream.file.read(stream.buffer.data() + stream.carry, static_cast<std::streamsize>(stream.buffer.size() - stream.carry));
+        size_t filled = stream.carry + static_cast<size_t>(stream.file.gcount());
+        if (filled == 0) 
+        {
+            batch.clear();
+            return 0;
+        }
+
+        const char* begin = stream.buffer.data();
+        const char* end = begin + filled;
+        if (!stream.file.eof()) 
+        {
+            const char* lastNewline = begin + filled;
+            while (lastNewline > begin && lastNewline[-1] != '\n') --lastNewline;
+            end = lastNewline;
+        }
+
+        // A Line Longer Than the Buffer, Grow and Read More
+        if (end == begin) 
+        {
+            stream.carry = filled;
+            stream.buffer.resize(stream.buffer.size() * 2);
+            continue;
+        }
+
+        parsePointTextParallel(begin, end, batch);
+        stream.carry = filled - (end - begin);
+        std::memmove(stream.buffer.data(), end, stream.carry);
+
+        // Skip Batches Made Only of Blank Lines
+        if (!batch.empty() || stream.file.eof()) return batch.size();
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "LasReader.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Sequential Reader That Holds Only One Batch of a Text or LAS File in Memory
+struct PointStream 
+{
+    std::ifstream file;
+    std::string filename;
+    bool las = false;
+    LasHeader header;
+    std::vector<char> buffer;
+    size_t carry = 0;
+    uint64_t nextRecord = 0;
+    uint64_t dataStart = 0;
+    size_t batchPoints = 0;
+};
+
+// Open a Stream That Returns Roughly batchPoints Points per Read
+bool openPointStream(const std::string& filename, PointStream& stream, size_t batchPoints);
+
+// Start Over From the First Point
+bool rewindPointStream(PointStream& stream);
+
+// Read the Next Batch Into batch, Returns 0 at the End of the File
+size_t readPointBatch(PointStream& stream, std::vector<Point>& batch);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+// Wall Clock Timer
+struct Stopwatch 
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    double seconds() const 
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Print Item Count, Elapsed Time and Rate
+inline void reportThroughput(const char* label, size_t count, double seconds, const char* unit = "points") 
+{
+    double rate = seconds > 0.0 ? count / seconds : 0.0;
+    std::cout << label << ": " << count << " " << unit << " in " << seconds * 1000.0 << " ms ("
+              << rate / 1.0e6 << " M" << unit << "/s)" << std::endl;
+}
+
+// Largest Resident Set Size of the Process So Far
+size_t peakMemoryBytes();
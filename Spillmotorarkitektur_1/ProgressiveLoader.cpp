@@ -0,0 +1,192 @@
+#include "ProgressiveLoader.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+namespace 
+{
+    // Target Chunk Size, Small Enough That Data Keeps Arriving Every Frame
+    const size_t textChunkBytes = size_t(4) << 20;
+    const size_t lasChunkRecords = size_t(1) << 17;
+
+    // Points in the Coarse Preview
+    const size_t previewPoints = 16384;
+
+    // Parse Single Lines Starting After Random Offsets
+    void buildTextPreview(ProgressiveLoad& load, const char* body, const char* end) 
+    {
+        std::mt19937_64 random(12345);
+        std::uniform_int_distribution<size_t> pick(0, static_cast<size_t>(end - body) - 1);
+        size_t samples = std::min(previewPoints, load.offsets.back());
+        for (size_t i = 0; i < samples; i++) 
+        {
+            const char* start = body + pick(random);
+            const char* newline = static_cast<const char*>(std::memchr(start, '\n', end - start));
+            if (!newline) continue;
+            const char* lineEnd = static_cast<const char*>(std::memchr(newline + 1, '\n', end - newline - 1));
+            Point point;
+            if (parsePointText(newline + 1, lineEnd ? lineEnd : end, &point) == 1) load.preview.push_back(point);
+        }
+    }
+
+    void buildLasPreview(ProgressiveLoad& load) 
+    {
+        if (load.header.pointCount == 0) return;
+        std::mt19937_64 random(12345);
+        std::uniform_int_distribution<uint64_t> pick(0, load.header.pointCount - 1);
+        load.preview.resize(std::min<uint64_t>(previewPoints, load.header.pointCount));
+        for (Point& point : load.preview) 
+        {
+            const char* record = load.file.data() + load.header.pointOffset + pick(random) * load.header.recordLength;
+            decodeLasPoints(record, load.header, 1, &point, nullptr, nullptr, nullptr);
+        }
+    }
+
+    // Split the File, Size the Output, Then Parse Chunks in Shuffled Order
+    void coordinate(ProgressiveLoad& load) 
+    {
+        const char* body = nullptr;
+        const char* end = load.file.data() + load.file.size();
+        size_t chunkCount = 0;
+        if (load.las) 
+        {
+            size_t count = static_cast<size_t>(load.header.pointCount);
+            chunkCount = (count + lasChunkRecords - 1) / lasChunkRecords;
+            load.offsets.resize(chunkCount + 1);
+            load.parsed.resize(chunkCount);
+            for (size_t c = 0; c < chunkCount; c++) 
+            {
+                load.offsets[c] = c * lasChunkRecords;
+                load.parsed[c] = std::min(lasChunkRecords, count - load.offsets[c]);
+            }
+            load.offsets[chunkCount] = count;
+            load.points.resize(count);
+            load.attributes.intensity.resize(count);
+            load.attributes.classification.resize(count);
+            load.attributes.returnNumber.resize(count);
+        }
+        else 
+        {
+            size_t numPoints = 0;
+            body = parseTextHeader(load.file.data(), end, numPoints);
+            load.chunks = splitLines(body, end, std::max<size_t>(workerCount() * 8, (end - body) / textChunkBytes));
+            chunkCount = load.chunks.size();
+            load.offsets.assign(chunkCount + 1, 0);
+            load.parsed.assign(chunkCount, 0);
+            parallelTasks(chunkCount, [&](size_t c, unsigned) 
+            {
+                load.offsets[c + 1] = countLines(load.chunks[c].begin, load.chunks[c].end);
+            });
+            for (size_t c = 0; c < chunkCount; c++) load.offsets[c + 1] += load.offsets[c];
+            if (numPoints != load.offsets.back()) 
+            {
+                std::cerr << "Header declares " << numPoints << " points but file holds " << load.offsets.back() << std::endl;
+            }
+
+            // Line Counts Are Exact, Unlike a Header That May Be Corrupt
+            load.points.resize(load.offsets.back());
+        }
+        load.chunkBounds.assign(chunkCount, emptyBounds());
+        load.ready.reset(new LockFreeQueue<uint32_t>(chunkCount + 1));
+        load.layoutReady.store(true, std::memory_order_release);
+
+        std::vector<uint32_t> order(chunkCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::shuffle(order.begin(), order.end(), std::mt19937(12345));
+
+        // Task 0 Is the Preview, Handed Out Before Any Chunk
+        parallelTasks(chunkCount + 1, [&](size_t task, unsigned) 
+        {
+            if (task == 0) 
+            {
+                if (load.las) buildLasPreview(load);
+                else if (end > body) buildTextPreview(load, body, end);
+                load.previewBounds = computeBounds(load.preview.data(), load.preview.size());
+                load.previewReady.store(true, std::memory_order_release);
+                return;
+            }
+
+            if (load.cancelled.load(std::memory_order_relaxed)) return;
+            uint32_t c = order[task - 1];
+            Point* out = load.points.data() + load.offsets[c];
+            if (load.las) 
+            {
+                size_t first = load.offsets[c];
+                decodeLasPoints(load.file.data() + load.header.pointOffset + first * load.header.recordLength, load.header,
+                                load.parsed[c], out, load.attributes.intensity.data() + first,
+                                load.attributes.classification.data() + first, load.attributes.returnNumber.data() + first,
+                                &load.chunkBounds[c]);
+            }
+            else 
+            {
+                load.parsed[c] = parsePointText(load.chunks[c].begin, load.chunks[c].end, out, &load.chunkBounds[c]);
+            }
+            load.ready->push(c);
+        });
+    }
+}
+
+bool startProgressiveLoad(ProgressiveLoad& load, const std::string& filename) 
+{
+    load.filename = filename;
+    if (!load.file.open(filename)) 
+    {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    load.las = isLasFile(filename);
+    if (load.las && !readLasHeader(load.file.data(), load.file.size(), load.header)) return false;
+
+    load.coordinator = std::thread(coordinate, std::ref(load));
+    return true;
+}
+
+size_t progressiveChunkCount(const ProgressiveLoad& load) 
+{
+    return load.parsed.size();
+}
+
+bool nextLoadedChunk(ProgressiveLoad& load, uint32_t& chunk) 
+{
+    return load.layoutReady.load(std::memory_order_acquire) && load.ready->pop(chunk);
+}
+
+Bounds loadedBounds(const ProgressiveLoad& load) 
+{
+    Bounds bounds = emptyBounds();
+    for (size_t c = 0; c < load.parsed.size(); c++) 
+    {
+        if (load.parsed[c] > 0) includeBounds(bounds, load.chunkBounds[c]);
+    }
+    return bounds;
+}
+
+Bounds finishProgressiveLoad(ProgressiveLoad& load) 
+{
+    if (load.coordinator.joinable()) load.coordinator.join();
+
+    size_t count = 0;
+    for (size_t c = 0; c < load.parsed.size(); c++) 
+    {
+        if (count != load.offsets[c]) 
+        {
+            std::memmove(load.points.data() + count, load.points.data() + load.offsets[c], load.parsed[c] * sizeof(Point));
+        }
+        count += load.parsed[c];
+    }
+    load.points.resize(count);
+    load.file.close();
+    return loadedBounds(load);
+}
+
+void cancelProgressiveLoad(ProgressiveLoad& load) 
+{
+    load.cancelled.store(true, std::memory_order_relaxed);
+    if (load.coordinator.joinable()) load.coordinator.join();
+}
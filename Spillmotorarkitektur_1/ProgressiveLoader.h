@@ -0,0 +1,60 @@
+#pragma once
+
+#include "LasReader.h"
+#include "LockFreeQueue.h"
+#include "MappedFile.h"
+#include "Point.h"
+#include "TerrainLoader.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Text or LAS File Parsed by Worker Threads While the Render Thread Uploads Finished Chunks
+struct ProgressiveLoad 
+{
+    std::string filename;
+    MappedFile file;
+    bool las = false;
+    LasHeader header;
+
+    // Chunk c Parses Into points[offsets[c]] and Yields parsed[c] Points With Bounds chunkBounds[c]
+    std::vector<TextChunk> chunks;
+    std::vector<size_t> offsets;
+    std::vector<size_t> parsed;
+    std::vector<Bounds> chunkBounds;
+    std::vector<Point> points;
+    PointAttributes attributes;
+
+    // Coarse Random Subsample Shown Before the First Chunk Arrives
+    std::vector<Point> preview;
+    Bounds previewBounds = {};
+
+    std::atomic<bool> layoutReady{ false };
+    std::atomic<bool> cancelled{ false };
+    std::atomic<bool> previewReady{ false };
+    std::unique_ptr<LockFreeQueue<uint32_t>> ready;
+    std::thread coordinator;
+};
+
+// Map the File and Start Parsing in the Background
+bool startProgressiveLoad(ProgressiveLoad& load, const std::string& filename);
+
+// Number of Chunks, Valid Once layoutReady Is Set
+size_t progressiveChunkCount(const ProgressiveLoad& load);
+
+// Take the Next Parsed Chunk, False if None Is Ready Yet
+bool nextLoadedChunk(ProgressiveLoad& load, uint32_t& chunk);
+
+// Bounds of All Parsed Points, Valid Once Every Chunk Has Been Taken
+Bounds loadedBounds(const ProgressiveLoad& load);
+
+// Wait for the Workers and Close Gaps Between Chunks, Returns Bounds of All Points
+Bounds finishProgressiveLoad(ProgressiveLoad& load);
+
+// Stop Parsing Early and Wait for the Workers
+void cancelProgressiveLoad(ProgressiveLoad& load);
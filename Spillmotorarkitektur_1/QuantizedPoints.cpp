@@ -0,0 +1,42 @@
+#include "QuantizedPoints.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace 
+{
+    uint16_t quantize(float value, float minimum, float scale) 
+    {
+        float q = std::round((value - minimum) * scale);
+        return static_cast<uint16_t>(std::min(std::max(q, 0.0f), quantizationSteps));
+    }
+
+    float stepScale(float minimum, float maximum) 
+    {
+        return maximum > minimum ? quantizationSteps / (maximum - minimum) : 0.0f;
+    }
+}
+
+float quantizationErrorBound(const Bounds& bounds) 
+{
+    float extent = std::max({ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY, bounds.maxZ - bounds.minZ });
+    return extent / quantizationSteps / 2.0f;
+}
+
+float quantizePoints(const Point* points, size_t count, const Bounds& bounds, QuantizedPoint* out) 
+{
+    float scaleX = stepScale(bounds.minX, bounds.maxX);
+    float scaleY = stepScale(bounds.minY, bounds.maxY);
+    float scaleZ = stepScale(bounds.minZ, bounds.maxZ);
+
+    float maxError = 0.0f;
+    for (size_t i = 0; i < count; i++) 
+    {
+        const Point& p = points[i];
+        out[i] = { quantize(p.x, bounds.minX, scaleX), quantize(p.y, bounds.minY, scaleY), quantize(p.z, bounds.minZ, scaleZ) };
+
+        Point decoded = dequantizePoint(out[i], bounds);
+        maxError = std::max({ maxError, std::abs(decoded.x - p.x), std::abs(decoded.y - p.y), std::abs(decoded.z - p.z) });
+    }
+    return maxError;
+}
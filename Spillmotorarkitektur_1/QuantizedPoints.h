@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Position Stored as Fractions of Its Tile's Bounds, Half the Size of a Point
+struct QuantizedPoint 
+{
+    uint16_t x, y, z;
+};
+
+// Run of Quantized Points Sharing One Bounding Box
+struct QuantizedTile 
+{
+    Bounds bounds;
+    size_t first;
+    size_t count;
+};
+
+// Largest Step Between Representable Values
+const float quantizationSteps = 65535.0f;
+
+// Worst Case Decoding Error for a Tile, Half a Step Along Its Widest Axis
+float quantizationErrorBound(const Bounds& bounds);
+
+// Quantize Points Against Tile Bounds, Returns the Largest Error Measured After Decoding
+float quantizePoints(const Point* points, size_t count, const Bounds& bounds, QuantizedPoint* out);
+
+// Same Decoding as the Vertex Shader
+inline Point dequantizePoint(const QuantizedPoint& q, const Bounds& bounds) 
+{
+    return { bounds.minX + q.x / quantizationSteps * (bounds.maxX - bounds.minX),
+             bounds.minY + q.y / quantizationSteps * (bounds.maxY - bounds.minY),
+             bounds.minZ + q.z / quantizationSteps * (bounds.maxZ - bounds.minZ) };
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Compile and Link a Vertex/Fragment Program, Returns 0 on Failure
+GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource);
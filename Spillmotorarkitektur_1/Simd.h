@@ -0,0 +1,70 @@
+#pragma once
+
+// SSE2 Is Part of Every x86-64 Target, Kernels Fall Back to Scalar Code Elsewhere
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// AVX2 Kernels Are Built Next to the Baseline on x86-64 and Picked at Runtime; GCC and Clang Need the Target per Function
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define SIMD_AVX2 1
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SIMD_TARGET_AVX2
+#endif
+#endif
+
+// Widest Instruction Set a Kernel May Use
+enum class SimdLevel 
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// What the Running CPU and OS Support, Limited to the Kernels This Build Contains; Probed Once, Then Cached
+inline SimdLevel detectSimdLevel() 
+{
+    static const SimdLevel level = []() 
+    {
+#if defined(SIMD_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) 
+        {
+            __cpuid(info, 1);
+            bool fma = (info[2] & (1 << 12)) != 0, osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            if (fma && osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6) return SimdLevel::Avx2;
+        }
+#elif defined(SIMD_AVX2)
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::Avx2;
+#endif
+#ifdef SIMD_SSE2
+        return SimdLevel::Sse2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+    return level;
+}
+
+// Index of the Lowest Set Bit, mask Must Not Be Zero
+inline unsigned lowestBit(unsigned mask) 
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
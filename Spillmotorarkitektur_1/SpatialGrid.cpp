@@ -0,0 +1,287 @@
+#include "SpatialGrid.h"
+#include "MortonSort.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace 
+{
+    // Cap on Cells So Sparse Outliers Cannot Blow Up the Offset Table
+    const size_t maxCells = size_t(1) << 26;
+
+    // Cell Coordinates Clamped to One Past the Grid, So Far Queries Stay in int Range; NaN Lands Before the Grid
+    int clampCell(float cell, uint32_t cells) 
+    {
+        if (std::isnan(cell)) return -1;
+        return static_cast<int>(std::min(std::max(std::floor(cell), -1.0f), static_cast<float>(cells)));
+    }
+
+    // Queries With NaN or Infinite Coordinates, or a NaN Radius, Find Nothing; an Infinite Radius Means No Limit
+    bool finiteQuery(PlanePoint q, float radius) 
+    {
+        return std::isfinite(q.x) && std::isfinite(q.y) && !std::isnan(radius);
+    }
+
+    int cellColumn(const SpatialGrid& grid, float x) 
+    {
+        return clampCell((x - grid.minX) / grid.cellSize, grid.columns);
+    }
+
+    int cellRow(const SpatialGrid& grid, float y) 
+    {
+        return clampCell((y - grid.minY) / grid.cellSize, grid.rows);
+    }
+
+    // Visit Every Point of the Cells in a Clipped Column/Row Rectangle
+    template <typename Fn>
+    void visitCells(const SpatialGrid& grid, int x0, int y0, int x1, int y1, Fn&& fn) 
+    {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, static_cast<int>(grid.columns) - 1);
+        y1 = std::min(y1, static_cast<int>(grid.rows) - 1);
+        if (x0 > x1) return;
+        for (int y = y0; y <= y1; y++) 
+        {
+            // Cells of a Row Are Adjacent, So the Whole Span Is One Run of Points
+            size_t row = static_cast<size_t>(y) * grid.columns;
+            for (uint32_t i = grid.cellStart[row + x0]; i < grid.cellStart[row + x1 + 1]; i++) fn(i);
+        }
+    }
+
+    // Keep the k Closest Seen So Far, Sorted, in Caller Storage
+    struct NearestList 
+    {
+        uint32_t* indices;
+        float* distances;
+        int k;
+        int size;
+
+        float worst() const { return size < k ? std::numeric_limits<float>::infinity() : distances[k - 1]; }
+
+        void offer(uint32_t index, float distance) 
+        {
+            if (distance >= worst()) return;
+            int slot = size < k ? size++ : k - 1;
+            while (slot > 0 && distances[slot - 1] > distance) 
+            {
+                distances[slot] = distances[slot - 1];
+                indices[slot] = indices[slot - 1];
+                slot--;
+            }
+            distances[slot] = distance;
+            indices[slot] = index;
+        }
+    };
+
+    // Search Square Rings of Cells Outward Until No Unvisited Cell Can Beat the Current k-th Distance
+    void searchNearest(const SpatialGrid& grid, PlanePoint q, float maxRadius, NearestList& list) 
+    {
+        float limit = maxRadius * maxRadius;
+        int cx = cellColumn(grid, q.x), cy = cellRow(grid, q.y);
+        int lastRing = std::max({ cx, cy, static_cast<int>(grid.columns) - 1 - cx, static_cast<int>(grid.rows) - 1 - cy });
+        auto consider = [&](uint32_t i) 
+        {
+            float dx = grid.points[i].x - q.x, dy = grid.points[i].y - q.y;
+            float distance = dx * dx + dy * dy;
+            if (distance <= limit) list.offer(i, distance);
+        };
+
+        for (int ring = 0; ring <= lastRing; ring++) 
+        {
+            // Cells in This Ring Lie Outside the Block of Rings Already Searched
+            float inner = std::min({ q.x - (grid.minX + (cx - ring + 1) * grid.cellSize), grid.minX + (cx + ring) * grid.cellSize - q.x,
+                                     q.y - (grid.minY + (cy - ring + 1) * grid.cellSize), grid.minY + (cy + ring) * grid.cellSize - q.y });
+            float reach = std::max(std::max(0, ring - 1) * grid.cellSize, inner);
+            if (reach * reach > std::min(limit, list.worst())) break;
+
+            if (ring == 0) 
+            {
+                visitCells(grid, cx, cy, cx, cy, consider);
+                continue;
+            }
+            visitCells(grid, cx - ring, cy - ring, cx + ring, cy - ring, consider);
+            visitCells(grid, cx - ring, cy + ring, cx + ring, cy + ring, consider);
+            visitCells(grid, cx - ring, cy - ring + 1, cx - ring, cy + ring - 1, consider);
+            visitCells(grid, cx + ring, cy - ring + 1, cx + ring, cy + ring - 1, consider);
+        }
+    }
+
+    // Count, Then Fill, So Each Batch Allocates Its Output Once; Totals Can Pass 2^32 Even Though Point Indices Cannot
+    template <typename Visit>
+    size_t collectBatch(size_t count, std::vector<size_t>& offsets, std::vector<uint32_t>& indices, Visit&& visit) 
+    {
+        offsets.assign(count + 1, 0);
+        parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t q = begin; q < end; q++) 
+            {
+                size_t hits = 0;
+                visit(q, [&](uint32_t) { hits++; });
+                offsets[q + 1] = hits;
+            }
+        });
+        for (size_t q = 0; q < count; q++) offsets[q + 1] += offsets[q];
+
+        indices.resize(offsets[count]);
+        parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+        {
+            for (size_t q = begin; q < end; q++) 
+            {
+                uint32_t* out = indices.data() + offsets[q];
+                visit(q, [&](uint32_t index) { *out++ = index; });
+            }
+        });
+        return indices.size();
+    }
+}
+
+bool buildSpatialGrid(const Point* points, size_t count, SpatialGrid& grid, float pointsPerCell) 
+{
+    grid = SpatialGrid();
+    if (count == 0 || count >= noPoint) return false;
+
+    Bounds bounds = computeBounds(points, count);
+    float width = std::max(bounds.maxX - bounds.minX, 1e-6f);
+    float depth = std::max(bounds.maxY - bounds.minY, 1e-6f);
+    float cells = std::min(static_cast<float>(maxCells), std::max(1.0f, count / pointsPerCell));
+    grid.cellSize = std::sqrt(width * depth / cells);
+    grid.columns = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(width / grid.cellSize)));
+    grid.rows = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(depth / grid.cellSize)));
+    while (size_t(grid.columns) * grid.rows > maxCells) 
+    {
+        grid.cellSize *= 1.25f;
+        grid.columns = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(width / grid.cellSize)));
+        grid.rows = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(depth / grid.cellSize)));
+    }
+    grid.minX = bounds.minX;
+    grid.minY = bounds.minY;
+
+    // Sort Point Indices by Cell, Then Read Off Where Each Cell Starts
+    std::vector<uint64_t> cellOf(count);
+    std::vector<uint32_t> order(count);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            int x = std::min(std::max(cellColumn(grid, points[i].x), 0), static_cast<int>(grid.columns) - 1);
+            int y = std::min(std::max(cellRow(grid, points[i].y), 0), static_cast<int>(grid.rows) - 1);
+            cellOf[i] = static_cast<uint64_t>(y) * grid.columns + x;
+            order[i] = static_cast<uint32_t>(i);
+        }
+    });
+    radixSortPairs(cellOf, order);
+
+    size_t cellCount = size_t(grid.columns) * grid.rows;
+    grid.cellStart.assign(cellCount + 1, 0);
+    for (size_t i = 0; i < count; i++) grid.cellStart[cellOf[i] + 1]++;
+    for (size_t c = 0; c < cellCount; c++) grid.cellStart[c + 1] += grid.cellStart[c];
+
+    grid.points.resize(count);
+    grid.sourceIndex = std::move(order);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) grid.points[i] = points[grid.sourceIndex[i]];
+    });
+    return true;
+}
+
+void nearestBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float maxRadius, uint32_t* nearest) 
+{
+    nearestKBatch(grid, queries, count, 1, maxRadius, nearest);
+}
+
+void nearestKBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, int k, float maxRadius, uint32_t* out,
+                   float* squaredDistances) 
+{
+    k = std::min(std::max(k, 1), maxNeighbors);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        float scratch[maxNeighbors];
+        for (size_t q = begin; q < end; q++) 
+        {
+            uint32_t* indices = out + q * k;
+            float* distances = squaredDistances ? squaredDistances + q * k : scratch;
+            NearestList list = { indices, distances, k, 0 };
+            if (!grid.points.empty() && finiteQuery(queries[q], maxRadius)) searchNearest(grid, queries[q], maxRadius, list);
+
+            for (int i = 0; i < list.size; i++) indices[i] = grid.sourceIndex[indices[i]];
+            for (int i = list.size; i < k; i++) 
+            {
+                indices[i] = noPoint;
+                distances[i] = std::numeric_limits<float>::infinity();
+            }
+        }
+    });
+}
+
+size_t radiusBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float radius,
+                   std::vector<size_t>& offsets, std::vector<uint32_t>& indices) 
+{
+    float limit = radius * radius;
+    return collectBatch(count, offsets, indices, [&](size_t q, auto&& emit) 
+    {
+        PlanePoint p = queries[q];
+        if (grid.points.empty() || !finiteQuery(p, radius)) return;
+        visitCells(grid, cellColumn(grid, p.x - radius), cellRow(grid, p.y - radius), cellColumn(grid, p.x + radius),
+                   cellRow(grid, p.y + radius), [&](uint32_t i) 
+        {
+            float dx = grid.points[i].x - p.x, dy = grid.points[i].y - p.y;
+            if (dx * dx + dy * dy <= limit) emit(grid.sourceIndex[i]);
+        });
+    });
+}
+
+size_t boxBatch(const SpatialGrid& grid, const Bounds* boxes, size_t count, std::vector<size_t>& offsets,
+                std::vector<uint32_t>& indices) 
+{
+    return collectBatch(count, offsets, indices, [&](size_t q, auto&& emit) 
+    {
+        const Bounds& box = boxes[q];
+        if (grid.points.empty() || !finiteQuery({ box.minX, box.minY }, 0.0f) || !finiteQuery({ box.maxX, box.maxY }, 0.0f)) return;
+        visitCells(grid, cellColumn(grid, box.minX), cellRow(grid, box.minY), cellColumn(grid, box.maxX), cellRow(grid, box.maxY),
+                   [&](uint32_t i) 
+        {
+            const Point& p = grid.points[i];
+            if (p.x >= box.minX && p.x <= box.maxX && p.y >= box.minY && p.y <= box.maxY) emit(grid.sourceIndex[i]);
+        });
+    });
+}
+
+void heightAtBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float maxRadius, float* heights, int k) 
+{
+    k = std::min(std::max(k, 1), maxNeighbors);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        uint32_t indices[maxNeighbors];
+        float distances[maxNeighbors];
+        for (size_t q = begin; q < end; q++) 
+        {
+            NearestList list = { indices, distances, k, 0 };
+            if (!grid.points.empty() && finiteQuery(queries[q], maxRadius)) searchNearest(grid, queries[q], maxRadius, list);
+            if (list.size == 0) 
+            {
+                heights[q] = std::numeric_limits<float>::quiet_NaN();
+                continue;
+            }
+
+            // An Exact Hit Takes Its Own Height
+            if (distances[0] == 0.0f) 
+            {
+                heights[q] = grid.points[indices[0]].z;
+                continue;
+            }
+            double weighted = 0.0, weights = 0.0;
+            for (int i = 0; i < list.size; i++) 
+            {
+                double weight = 1.0 / distances[i];
+                weighted += weight * grid.points[indices[i]].z;
+                weights += weight;
+            }
+            heights[q] = static_cast<float>(weighted / weights);
+        }
+    });
+}
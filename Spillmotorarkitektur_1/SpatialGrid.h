@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Query Position on the XY Plane
+struct PlanePoint 
+{
+    float x, y;
+};
+
+// Index Value Meaning No Point Was Found
+const uint32_t noPoint = 0xFFFFFFFFu;
+
+// Largest k Accepted by k-Nearest Queries
+const int maxNeighbors = 64;
+
+// Uniform XY Grid With Points Stored Cell by Cell (Compressed Rows)
+struct SpatialGrid 
+{
+    float minX = 0.0f, minY = 0.0f;
+    float cellSize = 1.0f;
+    uint32_t columns = 0, rows = 0;
+    std::vector<uint32_t> cellStart;
+    std::vector<Point> points;
+    std::vector<uint32_t> sourceIndex;
+};
+
+// Bin Points Into Cells Holding About pointsPerCell Each, in Parallel
+bool buildSpatialGrid(const Point* points, size_t count, SpatialGrid& grid, float pointsPerCell = 8.0f);
+
+// Nearest Point per Query in XY, noPoint When None Lies Within maxRadius or the Query Is Not Finite
+void nearestBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float maxRadius, uint32_t* nearest);
+
+// k Nearest per Query at out[q * k], Closest First and Padded With noPoint; squaredDistances May Be Null
+void nearestKBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, int k, float maxRadius, uint32_t* out,
+                   float* squaredDistances = nullptr);
+
+// Points Within radius of Each Query, Query q's Hits Are indices[offsets[q]] to indices[offsets[q + 1]]
+size_t radiusBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float radius,
+                   std::vector<size_t>& offsets, std::vector<uint32_t>& indices);
+
+// Points Inside Each XY Box, Laid Out Like radiusBatch
+size_t boxBatch(const SpatialGrid& grid, const Bounds* boxes, size_t count, std::vector<size_t>& offsets,
+                std::vector<uint32_t>& indices);
+
+// Inverse-Distance Weighted Height of the k Nearest Points, NaN Where None Lies Within maxRadius
+void heightAtBatch(const SpatialGrid& grid, const PlanePoint* queries, size_t count, float maxRadius, float* heights, int k = 4);
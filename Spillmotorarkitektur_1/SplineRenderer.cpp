@@ -0,0 +1,124 @@
+#include "SplineRenderer.h"
+#include "MeshPacking.h"
+#include "Shader.h"
+
+#include <gtc/type_ptr.hpp>
+
+#include <vector>
+
+namespace 
+{
+    const char* splineVertexShader = R"(#version 330 core
+layout(location = 0) in vec3 position;
+uniform mat4 mvp;
+void main()
+{
+    gl_Position = mvp * vec4(position, 1.0);
+}
+)";
+
+    const char* splineFragmentShader = R"(#version 330 core
+uniform vec3 surfaceColor;
+out vec4 color;
+void main()
+{
+    color = vec4(surfaceColor, 1.0);
+}
+)";
+
+    // Lines Along Both Parameter Directions, Then Two Triangles per Cell in Vertex-Cache Order, Joined Into Strips
+    void buildGridIndices(SplineRenderer& renderer, uint32_t columns, uint32_t rows) 
+    {
+        std::vector<uint32_t> lines, triangles;
+        for (uint32_t row = 0; row < rows; row++) 
+        {
+            for (uint32_t column = 0; column < columns; column++) 
+            {
+                uint32_t corner = row * columns + column;
+                if (column + 1 < columns) lines.insert(lines.end(), { corner, corner + 1 });
+                if (row + 1 < rows) lines.insert(lines.end(), { corner, corner + columns });
+                if (column + 1 < columns && row + 1 < rows) 
+                {
+                    triangles.insert(triangles.end(), { corner, corner + 1, corner + columns + 1, corner, corner + columns + 1, corner + columns });
+                }
+            }
+        }
+        reorderTriangles(triangles, vertexCacheOrder(triangles.data(), triangles.size(), size_t(columns) * rows));
+        std::vector<uint32_t> strips = buildTriangleStrips(triangles);
+
+        renderer.lineIndices = static_cast<GLsizei>(lines.size());
+        renderer.stripIndices = static_cast<GLsizei>(strips.size());
+        lines.insert(lines.end(), strips.begin(), strips.end());
+        glBindVertexArray(renderer.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(lines.size() * sizeof(uint32_t)), lines.data(), GL_STATIC_DRAW);
+        glBindVertexArray(0);
+    }
+}
+
+bool createSplineRenderer(SplineRenderer& renderer) 
+{
+    renderer.program = createShaderProgram(splineVertexShader, splineFragmentShader);
+    if (!renderer.program) return false;
+    renderer.mvpLocation = glGetUniformLocation(renderer.program, "mvp");
+    renderer.colorLocation = glGetUniformLocation(renderer.program, "surfaceColor");
+
+    glGenVertexArrays(1, &renderer.vao);
+    glGenBuffers(1, &renderer.vbo);
+    glGenBuffers(1, &renderer.ebo);
+    glBindVertexArray(renderer.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderer.ebo);
+    glBindVertexArray(0);
+    return true;
+}
+
+void uploadSplineGrid(SplineRenderer& renderer, const glm::vec3* vertices, uint32_t columns, uint32_t rows) 
+{
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(size_t(columns) * rows * sizeof(glm::vec3));
+    glBindBuffer(GL_ARRAY_BUFFER, renderer.vbo);
+    if (columns != renderer.columns || rows != renderer.rows) 
+    {
+        glBufferData(GL_ARRAY_BUFFER, bytes, vertices, GL_DYNAMIC_DRAW);
+        buildGridIndices(renderer, columns, rows);
+        renderer.columns = columns;
+        renderer.rows = rows;
+    }
+    else glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices);
+}
+
+void drawSplineGrid(const SplineRenderer& renderer, const glm::mat4& mvp, bool wireframe) 
+{
+    glUseProgram(renderer.program);
+    glUniformMatrix4fv(renderer.mvpLocation, 1, GL_FALSE, glm::value_ptr(mvp));
+    glBindVertexArray(renderer.vao);
+    if (wireframe) 
+    {
+        glUniform3f(renderer.colorLocation, 1.0f, 1.0f, 1.0f);
+        glDrawElements(GL_LINES, renderer.lineIndices, GL_UNSIGNED_INT, nullptr);
+    }
+    else 
+    {
+        // Pushed Back in Depth, So Grid Lines Drawn Over the Fill Are Not Hidden by It
+        glUniform3f(renderer.colorLocation, 0.25f, 0.35f, 0.5f);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(stripRestart);
+        glDrawElements(GL_TRIANGLE_STRIP, renderer.stripIndices, GL_UNSIGNED_INT, reinterpret_cast<const void*>(renderer.lineIndices * sizeof(uint32_t)));
+        glDisable(GL_PRIMITIVE_RESTART);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+    }
+    glBindVertexArray(0);
+}
+
+void destroySplineRenderer(SplineRenderer& renderer) 
+{
+    glDeleteBuffers(1, &renderer.ebo);
+    glDeleteBuffers(1, &renderer.vbo);
+    glDeleteVertexArrays(1, &renderer.vao);
+    glDeleteProgram(renderer.program);
+    renderer = SplineRenderer();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm.hpp>
+
+#include <cstdint>
+
+// Tessellated Surface Grid on the GPU: Vertex (column, row) Sits at row * columns + column, Line Indices Precede
+// Triangle Strip Indices in One Element Buffer
+struct SplineRenderer 
+{
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLint mvpLocation = -1;
+    GLint colorLocation = -1;
+    uint32_t columns = 0, rows = 0;
+    GLsizei lineIndices = 0;
+    GLsizei stripIndices = 0;
+};
+
+// Compile the Surface Shader and Create Empty Buffers
+bool createSplineRenderer(SplineRenderer& renderer);
+
+// Replace the Grid Positions; Indices Are Rebuilt Only When the Grid Size Changes
+void uploadSplineGrid(SplineRenderer& renderer, const glm::vec3* vertices, uint32_t columns, uint32_t rows);
+
+// One Draw Call: White Grid Lines, or Filled Triangle Strips Split by Primitive Restart and Offset Behind the Lines
+void drawSplineGrid(const SplineRenderer& renderer, const glm::mat4& mvp, bool wireframe = true);
+
+// Release GL Objects
+void destroySplineRenderer(SplineRenderer& renderer);
@@ -0,0 +1,205 @@
+#include "SurfaceQueries.h"
+#include "MortonSort.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace 
+{
+    // Cap on Cells So Long Thin Footprints Cannot Blow Up the Offset Table
+    const size_t maxCells = size_t(1) << 26;
+
+    // Steps a Hinted Walk May Take Before the Grid Takes Over
+    const int maxWalkSteps = 32;
+
+    // Barycentric Slack So Queries on Shared Edges Are Not Lost to Rounding
+    const double edgeTolerance = 1e-9;
+
+    int clampCell(float cell, uint32_t cells) 
+    {
+        return static_cast<int>(std::min(std::max(std::floor(cell), 0.0f), static_cast<float>(cells - 1)));
+    }
+
+    // Twice the Signed Area of abq, Positive When q Is Left of ab
+    double edgeSide(const Point& a, const Point& b, double x, double y) 
+    {
+        return (double(b.x) - a.x) * (y - a.y) - (double(b.y) - a.y) * (x - a.x);
+    }
+
+    const Point& corner(const TerrainMesh& mesh, uint32_t t, int i) 
+    {
+        return mesh.vertices[mesh.indices[3 * size_t(t) + i]];
+    }
+
+    // Barycentric Weights of (x, y) in Triangle t, Smallest Weight Returned
+    double barycentric(const TerrainMesh& mesh, uint32_t t, double x, double y, double weights[3]) 
+    {
+        const Point& a = corner(mesh, t, 0);
+        const Point& b = corner(mesh, t, 1);
+        const Point& c = corner(mesh, t, 2);
+        double area = edgeSide(a, b, c.x, c.y);
+        weights[0] = edgeSide(b, c, x, y) / area;
+        weights[1] = edgeSide(c, a, x, y) / area;
+        weights[2] = 1.0 - weights[0] - weights[1];
+        return std::min({ weights[0], weights[1], weights[2] });
+    }
+
+    // Step Toward (x, y) Across Any Edge It Lies Beyond; noTriangle When the Walk Leaves the Mesh or Runs Long
+    uint32_t walk(const TerrainMesh& mesh, uint32_t t, double x, double y) 
+    {
+        for (int step = 0; step < maxWalkSteps; step++) 
+        {
+            int exit = -1;
+            for (int i = 0; i < 3 && exit < 0; i++) 
+            {
+                if (edgeSide(corner(mesh, t, (i + 1) % 3), corner(mesh, t, (i + 2) % 3), x, y) < 0.0) exit = i;
+            }
+            if (exit < 0) return t;
+            t = mesh.neighbors[3 * size_t(t) + exit];
+            if (t == noTriangle) return noTriangle;
+        }
+        return noTriangle;
+    }
+
+    // Containing Triangle From the Cell's Candidates, the Least Violating One Within Tolerance
+    uint32_t gridLookup(const TerrainMesh& mesh, const TriangleGrid& grid, double x, double y) 
+    {
+        float column = (static_cast<float>(x) - grid.minX) / grid.cellSize;
+        float row = (static_cast<float>(y) - grid.minY) / grid.cellSize;
+        if (!(column >= 0.0f && row >= 0.0f && column <= grid.columns && row <= grid.rows)) return noTriangle;
+
+        size_t cell = size_t(clampCell(row, grid.rows)) * grid.columns + clampCell(column, grid.columns);
+        uint32_t best = noTriangle;
+        double bestWeight = -edgeTolerance;
+        for (uint32_t i = grid.cellStart[cell]; i < grid.cellStart[cell + 1]; i++) 
+        {
+            double weights[3];
+            double weight = barycentric(mesh, grid.triangles[i], x, y, weights);
+            if (weight >= 0.0) return grid.triangles[i];
+            if (weight >= bestWeight) 
+            {
+                bestWeight = weight;
+                best = grid.triangles[i];
+            }
+        }
+        return best;
+    }
+
+    void sampleTriangle(const TerrainMesh& mesh, uint32_t t, double x, double y, SurfaceSample& sample) 
+    {
+        const Point& a = corner(mesh, t, 0);
+        const Point& b = corner(mesh, t, 1);
+        const Point& c = corner(mesh, t, 2);
+        double weights[3];
+        barycentric(mesh, t, x, y, weights);
+        sample.height = static_cast<float>(weights[0] * a.z + weights[1] * b.z + weights[2] * c.z);
+        glm::vec3 ab(b.x - a.x, b.y - a.y, b.z - a.z), ac(c.x - a.x, c.y - a.y, c.z - a.z);
+        sample.normal = glm::normalize(glm::cross(ab, ac));
+        sample.triangle = t;
+    }
+}
+
+bool buildTriangleGrid(const TerrainMesh& mesh, TriangleGrid& grid, float trianglesPerCell) 
+{
+    grid = TriangleGrid();
+    size_t triangleCount = mesh.triangleCount();
+    if (triangleCount == 0) return false;
+
+    Bounds bounds = emptyBounds();
+    for (const Point& v : mesh.vertices) includePoint(bounds, v);
+    float width = std::max(bounds.maxX - bounds.minX, 1e-6f);
+    float depth = std::max(bounds.maxY - bounds.minY, 1e-6f);
+    float cells = std::min(static_cast<float>(maxCells), std::max(1.0f, triangleCount / trianglesPerCell));
+    grid.cellSize = std::sqrt(width * depth / cells);
+    grid.columns = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(width / grid.cellSize)));
+    grid.rows = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(depth / grid.cellSize)));
+    grid.minX = bounds.minX;
+    grid.minY = bounds.minY;
+
+    // Cell Rectangle Covered by Each Triangle's Bounding Box
+    auto cellRange = [&](size_t t, int& x0, int& y0, int& x1, int& y1) 
+    {
+        const Point& a = corner(mesh, static_cast<uint32_t>(t), 0);
+        const Point& b = corner(mesh, static_cast<uint32_t>(t), 1);
+        const Point& c = corner(mesh, static_cast<uint32_t>(t), 2);
+        x0 = clampCell((std::min({ a.x, b.x, c.x }) - grid.minX) / grid.cellSize, grid.columns);
+        x1 = clampCell((std::max({ a.x, b.x, c.x }) - grid.minX) / grid.cellSize, grid.columns);
+        y0 = clampCell((std::min({ a.y, b.y, c.y }) - grid.minY) / grid.cellSize, grid.rows);
+        y1 = clampCell((std::max({ a.y, b.y, c.y }) - grid.minY) / grid.cellSize, grid.rows);
+    };
+
+    // Count Entries per Triangle, Then Emit (Cell, Triangle) Pairs and Sort Them by Cell
+    std::vector<uint64_t> entryStart(triangleCount + 1, 0);
+    parallelFor(triangleCount, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t t = begin; t < end; t++) 
+        {
+            int x0, y0, x1, y1;
+            cellRange(t, x0, y0, x1, y1);
+            entryStart[t + 1] = uint64_t(x1 - x0 + 1) * (y1 - y0 + 1);
+        }
+    });
+    for (size_t t = 0; t < triangleCount; t++) entryStart[t + 1] += entryStart[t];
+    if (entryStart[triangleCount] >= std::numeric_limits<uint32_t>::max()) return false;
+
+    std::vector<uint64_t> cellOf(entryStart[triangleCount]);
+    std::vector<uint32_t> triangles(entryStart[triangleCount]);
+    parallelFor(triangleCount, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t t = begin; t < end; t++) 
+        {
+            int x0, y0, x1, y1;
+            cellRange(t, x0, y0, x1, y1);
+            size_t entry = entryStart[t];
+            for (int y = y0; y <= y1; y++) 
+            {
+                for (int x = x0; x <= x1; x++, entry++) 
+                {
+                    cellOf[entry] = uint64_t(y) * grid.columns + x;
+                    triangles[entry] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+    });
+    radixSortPairs(cellOf, triangles);
+
+    size_t cellCount = size_t(grid.columns) * grid.rows;
+    grid.cellStart.assign(cellCount + 1, 0);
+    for (uint64_t cell : cellOf) grid.cellStart[cell + 1]++;
+    for (size_t c = 0; c < cellCount; c++) grid.cellStart[c + 1] += grid.cellStart[c];
+    grid.triangles = std::move(triangles);
+    return true;
+}
+
+void sampleSurfaceBatch(const TerrainMesh& mesh, const TriangleGrid& grid, const PlanePoint* queries, size_t count,
+                        SurfaceSample* samples) 
+{
+    uint32_t triangleCount = static_cast<uint32_t>(mesh.triangleCount());
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t q = begin; q < end; q++) 
+        {
+            double x = queries[q].x, y = queries[q].y;
+            uint32_t hint = samples[q].triangle;
+
+            // Every Edge Test Is False for NaN, So a Walk Would Stop on Its Hint; Non-Finite Queries Are Off the Mesh
+            uint32_t t = noTriangle;
+            if (std::isfinite(x) && std::isfinite(y)) 
+            {
+                if (hint < triangleCount) t = walk(mesh, hint, x, y);
+                if (t == noTriangle && !grid.cellStart.empty()) t = gridLookup(mesh, grid, x, y);
+            }
+
+            if (t == noTriangle) 
+            {
+                samples[q].height = std::numeric_limits<float>::quiet_NaN();
+                samples[q].normal = glm::vec3(0.0f, 0.0f, 1.0f);
+                samples[q].triangle = noTriangle;
+                continue;
+            }
+            sampleTriangle(mesh, t, x, y, samples[q]);
+        }
+    });
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Delaunay.h"
+#include "SpatialGrid.h"
+
+#include <glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform XY Grid Listing the Triangles Whose Bounding Box Touches Each Cell (Compressed Rows)
+struct TriangleGrid 
+{
+    float minX = 0.0f, minY = 0.0f;
+    float cellSize = 1.0f;
+    uint32_t columns = 0, rows = 0;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> triangles;
+};
+
+// Surface Under One Query; triangle Is noTriangle and height NaN Off the Mesh or for Non-Finite Queries
+struct SurfaceSample 
+{
+    float height;
+    glm::vec3 normal;
+    uint32_t triangle;
+};
+
+// Bin Triangles Into Cells Holding About trianglesPerCell Each
+bool buildTriangleGrid(const TerrainMesh& mesh, TriangleGrid& grid, float trianglesPerCell = 2.0f);
+
+// Height, Upward Normal and Triangle Under Each Query, in Parallel; samples[q].triangle Is Read First as a Walking Hint
+// (the Previous Frame's Answer, or noTriangle), Falling Back to the Grid When the Walk Runs Long or Leaves the Mesh
+void sampleSurfaceBatch(const TerrainMesh& mesh, const TriangleGrid& grid, const PlanePoint* queries, size_t count,
+                        SurfaceSample* samples);
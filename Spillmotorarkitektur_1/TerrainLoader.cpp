@@ -0,0 +1,168 @@
+#include "TerrainLoader.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "PointBounds.h"
+#include "Profiling.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+namespace 
+{
+    const char* skipBlanks(const char* p, const char* end) 
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p;
+    }
+
+    const char* nextLine(const char* p, const char* end) 
+    {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        return newline ? newline + 1 : end;
+    }
+
+    bool parseFloat(const char*& p, const char* end, float& value) 
+    {
+        p = skipBlanks(p, end);
+        if (p < end && *p == '+') ++p;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+}
+
+const char* parseTextHeader(const char* begin, const char* end, size_t& numPoints) 
+{
+    numPoints = 0;
+    const char* p = skipBlanks(begin, end);
+    unsigned long long count = 0;
+    std::from_chars_result result = std::from_chars(p, end, count);
+    if (result.ec != std::errc()) return begin;
+
+    // A Lone Integer Is the Header, Anything Else Is Already Data
+    p = skipBlanks(result.ptr, end);
+    if (p < end && *p != '\n') return begin;
+
+    numPoints = static_cast<size_t>(count);
+    return nextLine(p, end);
+}
+
+std::vector<TextChunk> splitLines(const char* begin, const char* end, size_t chunkCount) 
+{
+    std::vector<TextChunk> chunks;
+    size_t length = end - begin;
+    chunkCount = std::max<size_t>(1, std::min(chunkCount, length / 4096 + 1));
+    chunks.reserve(chunkCount);
+
+    const char* start = begin;
+    for (size_t i = 1; i <= chunkCount && start < end; i++) 
+    {
+        const char* stop = (i == chunkCount) ? end : nextLine(std::max(start, begin + length / chunkCount * i), end);
+        chunks.push_back({ start, stop });
+        start = stop;
+    }
+    return chunks;
+}
+
+size_t countLines(const char* begin, const char* end) 
+{
+    if (begin == end) return 0;
+    size_t lines = std::count(begin, end, '\n');
+    return end[-1] == '\n' ? lines : lines + 1;
+}
+
+size_t parsePointText(const char* begin, const char* end, Point* out, Bounds* bounds) 
+{
+    size_t count = 0, measured = 0;
+    for (const char* line = begin; line < end;) 
+    {
+        const char* p = line;
+        Point point;
+        if (parseFloat(p, end, point.x) && parseFloat(p, end, point.y) && parseFloat(p, end, point.z)) 
+        {
+            out[count++] = point;
+
+            // Fold Each Finished Block Into the Bounds While It Is Still in Cache
+            if (bounds && count - measured == boundsBlockPoints) 
+            {
+                includeBounds(*bounds, computeBounds(out + measured, boundsBlockPoints));
+                measured = count;
+            }
+        }
+        line = nextLine(p, end);
+    }
+    if (bounds) includeBounds(*bounds, computeBounds(out + measured, count - measured));
+    return count;
+}
+
+size_t parsePointTextParallel(const char* begin, const char* end, std::vector<Point>& points, Bounds* bounds) 
+{
+    std::vector<TextChunk> chunks = splitLines(begin, end, workerCount() * 8);
+
+    // Count Lines per Chunk to Find Each Chunk's Output Offset
+    std::vector<size_t> offsets(chunks.size() + 1, 0);
+    parallelTasks(chunks.size(), [&](size_t c, unsigned) 
+    {
+        offsets[c + 1] = countLines(chunks[c].begin, chunks[c].end);
+    });
+    for (size_t c = 0; c < chunks.size(); c++) 
+    {
+        offsets[c + 1] += offsets[c];
+    }
+    // Line Counts Are Exact, Unlike a Header That May Be Corrupt
+    points.resize(offsets.back());
+
+    // Parse Chunks in Parallel Straight Into Their Slots
+    std::vector<size_t> parsed(chunks.size(), 0);
+    std::vector<Bounds> chunkBounds(chunks.size(), emptyBounds());
+    parallelTasks(chunks.size(), [&](size_t c, unsigned) 
+    {
+        parsed[c] = parsePointText(chunks[c].begin, chunks[c].end, points.data() + offsets[c], bounds ? &chunkBounds[c] : nullptr);
+    });
+    if (bounds) 
+    {
+        for (const Bounds& b : chunkBounds) includeBounds(*bounds, b);
+    }
+
+    // Close Gaps Left by Blank or Malformed Lines
+    size_t count = 0;
+    for (size_t c = 0; c < chunks.size(); c++) 
+    {
+        if (count != offsets[c]) 
+        {
+            std::memmove(points.data() + count, points.data() + offsets[c], parsed[c] * sizeof(Point));
+        }
+        count += parsed[c];
+    }
+    points.resize(count);
+    return count;
+}
+
+std::vector<Point> loadTerrainData(const std::string& filename, Bounds* bounds) 
+{
+    std::vector<Point> points;
+    MappedFile file;
+    if (!file.open(filename)) 
+    {
+        std::cerr << "Failed to open file: " << filename << std::endl;
+        return points;
+    }
+
+    Stopwatch timer;
+    const char* end = file.data() + file.size();
+    size_t numPoints = 0;
+    const char* body = parseTextHeader(file.data(), end, numPoints);
+    size_t count = parsePointTextParallel(body, end, points, bounds);
+
+    if (numPoints != count) 
+    {
+        std::cerr << "Header declares " << numPoints << " points but file holds " << count << std::endl;
+    }
+
+    std::cout << "Loaded " << points.size() << " points." << std::endl;
+    reportThroughput("Parsed text", points.size(), timer.seconds());
+    return points;
+}
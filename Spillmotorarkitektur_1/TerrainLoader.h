@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Line-Aligned Byte Range of a Text File
+struct TextChunk 
+{
+    const char* begin;
+    const char* end;
+};
+
+// Skip Point Count Header, Returns Start of Coordinate Lines
+const char* parseTextHeader(const char* begin, const char* end, size_t& numPoints);
+
+// Split Text Into Roughly Equal Chunks That Start and End on Line Boundaries
+std::vector<TextChunk> splitLines(const char* begin, const char* end, size_t chunkCount);
+
+// Upper Bound on Points in a Range (One per Line)
+size_t countLines(const char* begin, const char* end);
+
+// Parse "x y z" Lines Into out, Returns Number of Points Written; Grows bounds if Given
+size_t parsePointText(const char* begin, const char* end, Point* out, Bounds* bounds = nullptr);
+
+// Parse a Line-Aligned Range in Parallel, Resizing points to Fit
+size_t parsePointTextParallel(const char* begin, const char* end, std::vector<Point>& points, Bounds* bounds = nullptr);
+
+// Load Data From File, Bounds Are Gathered While Parsing
+std::vector<Point> loadTerrainData(const std::string& filename, Bounds* bounds = nullptr);
@@ -0,0 +1,309 @@
+#include "VoxelThinning.h"
+#include "MortonSort.h"
+#include "Morton.h"
+#include "Parallel.h"
+#include "Profiling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace 
+{
+    const uint64_t emptyKey = ~uint64_t(0);
+    const uint32_t emptySlot = ~uint32_t(0);
+    const uint32_t maxCellsPerAxis = 1u << 21;
+
+    // Finalizer From MurmurHash3, Spreads Neighbouring Cells Across Partitions
+    uint64_t mixHash(uint64_t h) 
+    {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB93FE53B8D53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    uint64_t pointHash(const Point& p) 
+    {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return mixHash((uint64_t(bits[0]) << 32 | bits[1]) ^ mixHash(bits[2]));
+    }
+
+    size_t tableSize(size_t entries) 
+    {
+        size_t size = 16;
+        while (size < entries * 2) size *= 2;
+        return size;
+    }
+
+    // Running State of One Occupied Voxel
+    struct Cell 
+    {
+        uint32_t first;
+        uint32_t highest;
+        uint32_t count;
+        double sumX, sumY, sumZ;
+    };
+
+    // Voxel Kept by a Partition, Sorted by first Before Output
+    struct Kept 
+    {
+        uint32_t first;
+        uint32_t source;
+        Point point;
+    };
+
+    // Open-Addressing Set of Points, Equal Bit Patterns Are Duplicates
+    struct PointSet 
+    {
+        std::vector<uint32_t> slots;
+        size_t mask = 0;
+
+        explicit PointSet(size_t entries) : slots(tableSize(entries), emptySlot), mask(slots.size() - 1) {}
+
+        bool insert(const Point* points, uint32_t index) 
+        {
+            for (size_t slot = pointHash(points[index]) & mask;; slot = (slot + 1) & mask) 
+            {
+                if (slots[slot] == emptySlot) 
+                {
+                    slots[slot] = index;
+                    return true;
+                }
+                if (std::memcmp(&points[slots[slot]], &points[index], sizeof(Point)) == 0) return false;
+            }
+        }
+    };
+
+    // Open-Addressing Map From Voxel Key to Cell
+    struct CellMap 
+    {
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> cells;
+        size_t mask = 0;
+
+        explicit CellMap(size_t entries) : keys(tableSize(entries), emptyKey), cells(keys.size()), mask(keys.size() - 1) {}
+
+        // Returns the Cell Index, Adding the Key as cellCount if New
+        uint32_t find(uint64_t key, uint32_t cellCount, bool& added) 
+        {
+            for (size_t slot = mixHash(key) & mask;; slot = (slot + 1) & mask) 
+            {
+                if (keys[slot] == key) 
+                {
+                    added = false;
+                    return cells[slot];
+                }
+                if (keys[slot] == emptyKey) 
+                {
+                    keys[slot] = key;
+                    cells[slot] = cellCount;
+                    added = true;
+                    return cellCount;
+                }
+            }
+        }
+    };
+
+    template <typename T>
+    void gatherAttribute(const std::vector<T>& source, const std::vector<Kept>& kept, std::vector<T>& output) 
+    {
+        output.clear();
+        if (source.empty()) return;
+        output.resize(kept.size());
+        for (size_t i = 0; i < kept.size(); i++) output[i] = source[kept[i].source];
+    }
+}
+
+bool parseThinningMode(const std::string& name, ThinningMode& mode) 
+{
+    if (name == "first") mode = ThinningMode::First;
+    else if (name == "centroid") mode = ThinningMode::Centroid;
+    else if (name == "maxz") mode = ThinningMode::MaxZ;
+    else return false;
+    return true;
+}
+
+size_t thinPoints(const Point* points, size_t count, const PointAttributes& attributes, const Bounds& bounds,
+                  const ThinningSettings& settings, std::vector<Point>& output, PointAttributes& outputAttributes) 
+{
+    // Grow the Cell Until the Grid Fits 21 Bits per Axis
+    float extent = std::max({ bounds.maxX - bounds.minX, bounds.maxY - bounds.minY, bounds.maxZ - bounds.minZ });
+    float cellSize = settings.cellSize;
+    bool exactOnly = !(cellSize > 0.0f);
+    if (!exactOnly && extent / cellSize >= maxCellsPerAxis) 
+    {
+        cellSize = extent / (maxCellsPerAxis - 1);
+        std::cerr << "Thinning cell size raised to " << cellSize << " to fit the voxel grid" << std::endl;
+    }
+    float scale = exactOnly ? 0.0f : 1.0f / cellSize;
+
+    // Voxel Key per Point, or the Point Itself When Only Removing Duplicates
+    std::vector<uint64_t> keys(count);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned) 
+    {
+        for (size_t i = begin; i < end; i++) 
+        {
+            const Point& p = points[i];
+            if (exactOnly) 
+            {
+                keys[i] = pointHash(p) >> 1;
+                continue;
+            }
+            uint32_t x = std::min(static_cast<uint32_t>((p.x - bounds.minX) * scale), maxCellsPerAxis - 1);
+            uint32_t y = std::min(static_cast<uint32_t>((p.y - bounds.minY) * scale), maxCellsPerAxis - 1);
+            uint32_t z = std::min(static_cast<uint32_t>((p.z - bounds.minZ) * scale), maxCellsPerAxis - 1);
+            keys[i] = mortonEncode3(x, y, z);
+        }
+    });
+
+    // Partition by Key Hash So Each Partition Owns Its Voxels and Needs No Locks
+    unsigned workers = workerCount();
+    int partitionBits = 0;
+    while ((1u << partitionBits) < workers * 4) partitionBits++;
+    size_t partitionCount = size_t(1) << partitionBits;
+    auto partitionOf = [&](uint64_t key) { return partitionBits ? mixHash(key) >> (64 - partitionBits) : 0; };
+
+    std::vector<size_t> offsets(workers * partitionCount, 0);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+    {
+        size_t* histogram = offsets.data() + worker * partitionCount;
+        for (size_t i = begin; i < end; i++) histogram[partitionOf(keys[i])]++;
+    });
+    std::vector<size_t> partitionStart(partitionCount + 1, 0);
+    size_t offset = 0;
+    for (size_t part = 0; part < partitionCount; part++) 
+    {
+        partitionStart[part] = offset;
+        for (unsigned worker = 0; worker < workers; worker++) 
+        {
+            size_t& entry = offsets[worker * partitionCount + part];
+            size_t partCount = entry;
+            entry = offset;
+            offset += partCount;
+        }
+    }
+    partitionStart[partitionCount] = offset;
+
+    std::vector<uint32_t> order(count);
+    parallelFor(count, [&](size_t begin, size_t end, unsigned worker) 
+    {
+        size_t* next = offsets.data() + worker * partitionCount;
+        for (size_t i = begin; i < end; i++) order[next[partitionOf(keys[i])]++] = static_cast<uint32_t>(i);
+    });
+
+    // Each Partition Sees Its Points in Input Order, So first Is the Lowest Index
+    std::vector<std::vector<Kept>> partitionKept(partitionCount);
+    std::vector<size_t> partitionDuplicates(partitionCount, 0);
+    parallelTasks(partitionCount, [&](size_t part, unsigned) 
+    {
+        size_t begin = partitionStart[part], end = partitionStart[part + 1];
+        PointSet seen(end - begin);
+        CellMap map(exactOnly ? 0 : end - begin);
+        std::vector<Cell> cells;
+        for (size_t o = begin; o < end; o++) 
+        {
+            uint32_t index = order[o];
+            if (!seen.insert(points, index)) 
+            {
+                partitionDuplicates[part]++;
+                continue;
+            }
+            if (exactOnly) 
+            {
+                partitionKept[part].push_back({ index, index, points[index] });
+                continue;
+            }
+
+            bool added;
+            uint32_t c = map.find(keys[index], static_cast<uint32_t>(cells.size()), added);
+            const Point& p = points[index];
+            if (added) 
+            {
+                cells.push_back({ index, index, 1, p.x, p.y, p.z });
+                continue;
+            }
+            Cell& cell = cells[c];
+            if (p.z > points[cell.highest].z) cell.highest = index;
+            cell.count++;
+            cell.sumX += p.x;
+            cell.sumY += p.y;
+            cell.sumZ += p.z;
+        }
+
+        std::vector<Kept>& kept = partitionKept[part];
+        kept.reserve(kept.size() + cells.size());
+        for (const Cell& cell : cells) 
+        {
+            switch (settings.mode) 
+            {
+            case ThinningMode::First:
+                kept.push_back({ cell.first, cell.first, points[cell.first] });
+                break;
+            case ThinningMode::MaxZ:
+                kept.push_back({ cell.first, cell.highest, points[cell.highest] });
+                break;
+            case ThinningMode::Centroid:
+                kept.push_back({ cell.first, cell.first,
+                                 { static_cast<float>(cell.sumX / cell.count), static_cast<float>(cell.sumY / cell.count),
+                                   static_cast<float>(cell.sumZ / cell.count) } });
+                break;
+            }
+        }
+    });
+
+    // Restore Input Order
+    std::vector<Kept> kept;
+    size_t duplicates = 0;
+    for (size_t part = 0; part < partitionCount; part++) 
+    {
+        kept.insert(kept.end(), partitionKept[part].begin(), partitionKept[part].end());
+        duplicates += partitionDuplicates[part];
+    }
+    std::vector<uint64_t> firsts(kept.size());
+    std::vector<uint32_t> keptOrder(kept.size());
+    for (size_t i = 0; i < kept.size(); i++) 
+    {
+        firsts[i] = kept[i].first;
+        keptOrder[i] = static_cast<uint32_t>(i);
+    }
+    radixSortPairs(firsts, keptOrder);
+
+    std::vector<Kept> sorted(kept.size());
+    for (size_t i = 0; i < kept.size(); i++) sorted[i] = kept[keptOrder[i]];
+    output.resize(sorted.size());
+    for (size_t i = 0; i < sorted.size(); i++) output[i] = sorted[i].point;
+    gatherAttribute(attributes.intensity, sorted, outputAttributes.intensity);
+    gatherAttribute(attributes.classification, sorted, outputAttributes.classification);
+    gatherAttribute(attributes.returnNumber, sorted, outputAttributes.returnNumber);
+
+    std::cout << "Removed " << duplicates << " exact duplicates" << std::endl;
+    return output.size();
+}
+
+void thinPointCloud(PointCloud& cloud, const ThinningSettings& settings) 
+{
+    if (cloud.empty()) return;
+
+    Stopwatch timer;
+    std::vector<Point> points;
+    PointAttributes attributes;
+    size_t before = cloud.count;
+    thinPoints(cloud.points, cloud.count, cloud.attributes, cloud.bounds, settings, points, attributes);
+    double seconds = timer.seconds();
+
+    // Input Order Is Kept, So a Sorted Cloud Stays Sorted
+    bool sorted = cloud.mortonSorted;
+    Bounds bounds = cloud.bounds;
+    cloud.adopt(std::move(points), bounds);
+    cloud.attributes = std::move(attributes);
+    cloud.mortonSorted = sorted;
+
+    std::cout << "Thinned to " << cloud.count << " of " << before << " points (" << 100.0 * cloud.count / before
+              << "% retained)" << std::endl;
+    reportThroughput("Voxel thinning", before, seconds);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LasReader.h"
+#include "Point.h"
+#include "PointCloud.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Which Point Represents a Voxel
+enum class ThinningMode 
+{
+    First,
+    Centroid,
+    MaxZ
+};
+
+// Voxel Edge Length in Source Units, Zero Only Removes Exact Duplicates
+struct ThinningSettings 
+{
+    float cellSize = 0.0f;
+    ThinningMode mode = ThinningMode::First;
+};
+
+// Parse "first", "centroid" or "maxz"
+bool parseThinningMode(const std::string& name, ThinningMode& mode);
+
+// Keep One Point per Occupied Voxel in Input Order, Dropping Exact Duplicates Before They Reach a Voxel
+// Attributes Follow the First Point of a Voxel (the Highest for MaxZ)
+size_t thinPoints(const Point* points, size_t count, const PointAttributes& attributes, const Bounds& bounds,
+                  const ThinningSettings& settings, std::vector<Point>& output, PointAttributes& outputAttributes);
+
+// Replace a Cloud's Points With Their Thinned Set and Report the Retained Fraction
+void thinPointCloud(PointCloud& cloud, const ThinningSettings& settings);